@@ -21,6 +21,30 @@ OPTS+="-DBOUNDARY_TILE_I=64 "
 OPTS+="-DBOUNDARY_TILE_J=16 "
 OPTS+="-DBOUNDARY_TILE_K=16 "
 
+# autotune the (host) tile size per level during MGBuild, results are cached in hpgmg-fv.tiles
+#OPTS+="-DUSE_TILE_AUTOTUNE "
+
+# execute GSRB smooths and the residual on host levels as a graph of per-box OpenMP tasks
+#OPTS+="-DUSE_TASKS "
+
+# progress MPI (wait+unpack) on a dedicated pthread per process (requires MPI_THREAD_SERIALIZED)
+#OPTS+="-DUSE_COMM_THREAD "
+
+# send remote fine boxes the coarse data (plus halo) from which they are interpolated rather than the interpolated result (host levels)
+#OPTS+="-DUSE_RECEIVER_INTERPOLATION "
+
+# send long ghost zone pencils (k-faces, j-slabs) directly from/to the grid via MPI derived datatypes (host levels)
+#OPTS+="-DUSE_MPI_DATATYPES "
+
+# merge each process's boxes (host levels) into one brick with a single ghost zone shell (no on-process ghost zone copies)
+#OPTS+="-DUSE_BRICKS "
+
+# pad host levels' k-stride and the offset between vectors to minimize modeled cache set conflicts of the stencil sweeps
+#OPTS+="-DUSE_BOX_PADDING "
+
+# interleave each cell's operator coefficients (alpha, beta's, Dinv, L1inv) into one stream for the host fv4 kernels
+#OPTS+="-DUSE_PACKED_COEFFICIENTS "
+
 # host level threshold: number of grid elements
 OPTS+="-DHOST_LEVEL_SIZE_THRESHOLD=10000 "
 
@@ -46,6 +70,10 @@ OPTS+="-DGSRB_STRIDE2 "
 #OPTS+="-DGSRB_BRANCH "
 #OPTS+="-DGSRB_OOP "
 
+# SymGS smoother options (default is a lexicographic sweep of each box, threaded only across boxes)
+# -DSYMGS_WAVEFRONT threads the sweeps of each box across wavefronts of i-lines (bit-identical to the lexicographic sweep)
+#OPTS+="-DSYMGS_WAVEFRONT "
+
 # tools
 #OPTS+="-DUSE_PROFILE "
 #OPTS+="-DUSE_NVTX "
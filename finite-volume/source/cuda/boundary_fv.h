@@ -543,17 +543,10 @@ __global__ void extrapolate_betas_kernel(level_type level, int shape){
   const int       jlo = block.read.j;
   const int       klo = block.read.k;
 
-  // total hack/reuse of the existing boundary list...
-  //   however, whereas boundary subtype represents the normal to the domain at that point, 
-  //   one needs the box-relative (not domain-relative) normal when extending the face averaged beta's into the ghost zones
-  //   Thus, I reuse the list to tell me which areas are beyond the domain boundary, but must calculate their normals here
-  int   subtype = 13;
-  if(ilo <               0)subtype-=1;
-  if(jlo <               0)subtype-=3;
-  if(klo <               0)subtype-=9;
-  if(ilo >= level.box_dim)subtype+=1;
-  if(jlo >= level.box_dim)subtype+=3;
-  if(klo >= level.box_dim)subtype+=9;
+  // reuse the existing boundary list... its subtype is the normal to the *DOMAIN* (not the box) at that point.
+  //   Thus, wherever the ghost zones of several boxes overlap beyond the domain, each box extrapolates the same beta's (the communication-
+  //   avoiding chebyshev smoother recomputes its neighbors' cells), but the beta's must have been exchanged first
+  const int   subtype = block.subtype;
   const int    normal = 26-subtype; // invert the normal vector
  
   // hard code for box to box BC's 
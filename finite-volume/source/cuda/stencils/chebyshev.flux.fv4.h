@@ -65,9 +65,6 @@ __global__ void chebyshev_kernel(level_type level, int x_id, int rhs_id, double
       const double * __restrict__ beta_j   = level.my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride) + (ilo + jlo*jStride + klo*kStride);
       const double * __restrict__ beta_k   = level.my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride) + (ilo + jlo*jStride + klo*kStride);
       const double * __restrict__ Dinv     = level.my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride) + (ilo + jlo*jStride + klo*kStride);
-#ifdef STENCIL_FUSE_BC
-      const double * __restrict__ valid    = level.my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride) + (ilo + jlo*jStride + klo*kStride);
-#endif
             double * __restrict__ x_np1;
       const double * __restrict__ x_n;
       const double * __restrict__ x_nm1;
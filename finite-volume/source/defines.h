@@ -21,8 +21,17 @@
 //------------------------------------------------------------------------------------------------------------------
 #define  VECTOR_DINV         9 // cell centered relaxation parameter (e.g. inverse of the diagonal)
 #define  VECTOR_L1INV       10 // cell centered relaxation parameter (e.g. inverse of the L1 norm of each row)
-#define  VECTOR_VALID       11 // cell centered array noting which cells are actually present
+#define  VECTOR_VALID       11 // unused (never allocated)... cells actually present are described by box_type.valid
 //------------------------------------------------------------------------------------------------------------------
 #define VECTORS_RESERVED    12 // total number of vectors and the starting location for any auxillary bottom solver vectors
 //------------------------------------------------------------------------------------------------------------------------------
+// with -DUSE_PACKED_COEFFICIENTS, each cell's operator coefficients are also stored contiguously as PACKED_COEFS doubles
+#define  PACKED_ALPHA        0
+#define  PACKED_BETA_I       1
+#define  PACKED_BETA_J       2
+#define  PACKED_BETA_K       3
+#define  PACKED_DINV         4
+#define  PACKED_L1INV        5
+#define  PACKED_COEFS        6
+//------------------------------------------------------------------------------------------------------------------------------
 #endif
@@ -104,11 +104,8 @@ void bench_hpgmg(mg_type *all_grids, int onLevel, double a, double b, double dto
     MGResetTimers(all_grids);
     while( (numSolves<minSolves) ){
       zero_vector(all_grids->levels[onLevel],VECTOR_U);
-      #ifdef USE_FCYCLES
-      FMGSolve(all_grids,onLevel,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
-      #else
-       MGSolve(all_grids,onLevel,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
-      #endif
+      if(all_grids->options.cycle==MG_CYCLE_F)FMGSolve(all_grids,onLevel,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
+                                         else  MGSolve(all_grids,onLevel,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
       numSolves++;
     }
 
@@ -160,9 +157,20 @@ int main(int argc, char **argv){
     //requested_threading_model = MPI_THREAD_SERIALIZED;
     //requested_threading_model = MPI_THREAD_MULTIPLE;
     #endif
+    #ifdef USE_COMM_THREAD // the communication thread and the master thread make (serialized) MPI calls
+      requested_threading_model = MPI_THREAD_SERIALIZED;
+    #endif
   MPI_Init_thread(&argc, &argv, requested_threading_model, &actual_threading_model);
   MPI_Comm_size(MPI_COMM_WORLD, &num_tasks);
   MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+  #ifdef USE_COMM_THREAD
+  if(actual_threading_model<MPI_THREAD_SERIALIZED){
+    if(my_rank==0)fprintf(stderr,"-DUSE_COMM_THREAD requires MPI_THREAD_SERIALIZED\n");
+    MPI_Finalize();
+    exit(0);
+  }
+  comm_thread_start();
+  #endif
   // Set CUDA device for this rank...
   num_devices = cudaCheckPeerToPeer(my_rank);
   int my_device = my_rank % num_devices;
@@ -192,23 +200,39 @@ int main(int argc, char **argv){
 //int64_t target_memory_per_rank = -1; // not specified
   int64_t box_dim                = -1;
   int64_t boxes_in_i             = -1;
+  int64_t boxes_in_j             = -1;
+  int64_t boxes_in_k             = -1;
   int64_t target_boxes           = -1;
 
+  // runtime selection of the cycle, bottom solver, and smoother(s)... removes any recognized --options from argv
+  mg_options_type mg_options;
+  MGDefaultOptions(&mg_options);
+  if(!MGParseOptions(&mg_options,&argc,argv))argc=0; // force the usage message
+
   if(argc==3){
              log2_box_dim=atoi(argv[1]);
     target_boxes_per_rank=atoi(argv[2]);
+    box_dim = (log2_box_dim>=10) ? log2_box_dim : (log2_box_dim>=0) ? 1<<log2_box_dim : 0; // values of 10 or more are interpreted as box_dim itself (e.g. 48, 80, 96)
 
-    if(log2_box_dim>9){
+    if( (log2_box_dim>9) && (box_dim>512) ){
       // NOTE, in order to use 32b int's for array indexing, box volumes must be less than 2^31 doubles
-      if(my_rank==0){fprintf(stderr,"log2_box_dim must be less than 10\n");}
+      if(my_rank==0){fprintf(stderr,"log2_box_dim must be less than 10 (box_dim must be at most 512)\n");}
+      #ifdef USE_MPI
+      MPI_Finalize();
+      #endif
+      exit(0);
+    }
+
+    if( (log2_box_dim<4) || (box_dim<16) ){
+      if(my_rank==0){fprintf(stderr,"log2_box_dim must be at least 4 (box_dim must be at least 16)\n");}
       #ifdef USE_MPI
       MPI_Finalize();
       #endif
       exit(0);
     }
 
-    if(log2_box_dim<4){
-      if(my_rank==0){fprintf(stderr,"log2_box_dim must be at least 4\n");}
+    if(box_dim%2){
+      if(my_rank==0){fprintf(stderr,"box_dim must be even\n");}
       #ifdef USE_MPI
       MPI_Finalize();
       #endif
@@ -223,23 +247,28 @@ int main(int argc, char **argv){
       exit(0);
     }
 
-    #ifndef MAX_COARSE_DIM
-    #define MAX_COARSE_DIM 11
-    #endif
-    box_dim=1<<log2_box_dim;
     target_boxes = (int64_t)target_boxes_per_rank*(int64_t)num_tasks;
     boxes_in_i = -1;
-    int64_t bi;
-    for(bi=1;bi<1000;bi++){ // search all possible problem sizes to find acceptable boxes_in_i
-      int64_t total_boxes = bi*bi*bi;
-      if(total_boxes<=target_boxes){
-        int64_t coarse_grid_dim = box_dim*bi;
-        while( (coarse_grid_dim%2) == 0){coarse_grid_dim=coarse_grid_dim/2;}
-        if(coarse_grid_dim<=MAX_COARSE_DIM){
-          boxes_in_i = bi;
-        }
+    int64_t bi,bj,bk,best_boxes=0;
+    int aspect_limit;
+    for(aspect_limit=1;(aspect_limit>=0) && (best_boxes<num_tasks);aspect_limit--){ // prefer boxes_in_k <= 2*boxes_in_i, but accept any factorization rather than leave ranks without a box
+    for(bi=1;bi*bi*bi<=target_boxes;bi++){ // search all possible problem sizes to find acceptable boxes_in_i x boxes_in_j x boxes_in_k
+    for(bj=bi;(bi*bj*bj<=target_boxes) && (!aspect_limit || (bj<=2*bi));bj++){ // the domain may be rectangular, but boxes_in_i <= boxes_in_j <= boxes_in_k
+    for(bk=bj;!aspect_limit || (bk<=2*bi);bk++){
+      int64_t total_boxes = bi*bj*bk;
+      if(total_boxes>target_boxes)break;
+      int64_t coarse_grid_dim_i = box_dim*bi; // every dimension is coarsened until one of them is odd
+      int64_t coarse_grid_dim_j = box_dim*bj;
+      int64_t coarse_grid_dim_k = box_dim*bk;
+      while( ((coarse_grid_dim_i%2)==0) && ((coarse_grid_dim_j%2)==0) && ((coarse_grid_dim_k%2)==0) ){coarse_grid_dim_i/=2;coarse_grid_dim_j/=2;coarse_grid_dim_k/=2;}
+      if( (coarse_grid_dim_i>mg_options.max_coarse_dim) || (coarse_grid_dim_j>mg_options.max_coarse_dim) || (coarse_grid_dim_k>mg_options.max_coarse_dim) )continue;
+      if( (total_boxes>best_boxes) || ( (total_boxes==best_boxes) && (bk-bi < boxes_in_k-boxes_in_i) ) ){ // most boxes, then the most cubical
+        best_boxes = total_boxes;
+        boxes_in_i = bi;
+        boxes_in_j = bj;
+        boxes_in_k = bk;
       }
-    }
+    }}}}
     if(boxes_in_i<1){
       if(my_rank==0){fprintf(stderr,"failed to find an acceptable problem size\n");}
       #ifdef USE_MPI
@@ -247,6 +276,9 @@ int main(int argc, char **argv){
       #endif
       exit(0);
     }
+    if(best_boxes<num_tasks){
+      if(my_rank==0){fprintf(stderr,"  WARNING... only %ld boxes for %d ranks (%ld ranks will be idle)\n",(long)best_boxes,num_tasks,(long)(num_tasks-best_boxes));}
+    }
   } // argc==3
 
   #if 0
@@ -280,7 +312,7 @@ int main(int argc, char **argv){
 
 
   else{
-    if(my_rank==0){fprintf(stderr,"usage: ./hpgmg-fv  [log2_box_dim]  [target_boxes_per_rank]\n");}
+    if(my_rank==0){fprintf(stderr,"usage: ./hpgmg-fv  [log2_box_dim|box_dim]  [target_boxes_per_rank]  [--cycle=v|f|u]  [--bottom-solver=smooth|bicgstab|cg|cabicgstab|cacg]  [--smoother=gsrb|cheby|jacobi|l1jacobi|symgs|zline[,...]]  [--tune-smoothers[=factor]]  [--max-coarse-dim=N]  [--constant-coefficients[=auto]]  [--lanczos[=iterations]]  [--chebyshev-ca=steps[,...]]  [--cycle-index=1|2[,...]]  [--kcycle]  [--high-order-levels=N]\n");}
                  //fprintf(stderr,"       ./hpgmg-fv  [target_memory_per_rank[MB,GB,TB]]\n");}
     #ifdef USE_MPI
     MPI_Finalize();
@@ -312,6 +344,10 @@ int main(int argc, char **argv){
   else                                                       fprintf(stdout,"got Unknown MPI Threading Model (%d)\n",actual_threading_model);
   #endif
   fprintf(stdout,"%d MPI Tasks of %d threads\n",num_tasks,OMP_Threads);
+  #ifdef USE_COMM_THREAD
+  fprintf(stdout,"Using a dedicated communication thread per MPI task\n");
+  #endif
+  MGPrintOptions(&mg_options);
   fprintf(stdout,"\n\n===== Benchmark setup ==========================================================\n");
   }
 
@@ -326,8 +362,9 @@ int main(int argc, char **argv){
   int minCoarseDim = 1; // assumes you can drop order on the boundaries
   #endif
   level_type level_h;
-  int ghosts=stencil_get_radius();
-  create_level(&level_h,boxes_in_i,box_dim,ghosts,VECTORS_RESERVED,bc,my_rank,num_tasks,NULL);
+  int ghosts=stencil_get_radius()*MGChebyshevSteps(&mg_options,0); // deeper ghost zones for the communication-avoiding chebyshev smoother (--chebyshev-ca)
+  if(ghosts>box_dim)ghosts=(box_dim>stencil_get_radius()) ? box_dim : stencil_get_radius();
+  create_level(&level_h,boxes_in_i,boxes_in_j,boxes_in_k,box_dim,ghosts,VECTORS_RESERVED,bc,my_rank,num_tasks,NULL);
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
   #ifdef USE_HELMHOLTZ
   double a=1.0;double b=1.0; // Helmholtz
@@ -336,7 +373,7 @@ int main(int argc, char **argv){
   double a=0.0;double b=1.0; // Poisson
   if(my_rank==0)fprintf(stdout,"  Creating Poisson (a=%f, b=%f) test problem\n",a,b);
   #endif
-  double h=1.0/( (double)boxes_in_i*(double)box_dim );  // [0,1]^3 problem
+  double h=1.0/( (double)boxes_in_i*(double)box_dim );  // [0,1]^3 problem (stretched in j and k if the domain is rectangular)
   initialize_problem(&level_h,h,a,b);                   // initialize VECTOR_ALPHA, VECTOR_BETA*, and VECTOR_F
   rebuild_operator(&level_h,NULL,a,b);                  // calculate Dinv and lambda_max
   if(level_h.boundary_condition.type == BC_PERIODIC){   // remove any constants from the RHS for periodic problems
@@ -351,7 +388,7 @@ int main(int argc, char **argv){
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
   // create the MG hierarchy...
   mg_type MG_h;
-  MGBuild(&MG_h,&level_h,a,b,minCoarseDim);             // build the Multigrid Hierarchy 
+  MGBuild(&MG_h,&level_h,a,b,minCoarseDim,&mg_options); // build the Multigrid Hierarchy 
 
 
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -399,11 +436,8 @@ int main(int argc, char **argv){
   for(l=0;l<3;l++){
     if(l>0)restriction(MG_h.levels[l],VECTOR_F,MG_h.levels[l-1],VECTOR_F,RESTRICT_CELL);
            zero_vector(MG_h.levels[l],VECTOR_U);
-    #ifdef USE_FCYCLES
-    FMGSolve(&MG_h,l,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
-    #else
-     MGSolve(&MG_h,l,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
-    #endif
+    if(MG_h.options.cycle==MG_CYCLE_F)FMGSolve(&MG_h,l,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
+                                 else  MGSolve(&MG_h,l,VECTOR_U,VECTOR_F,a,b,dtol,rtol);
   }
   NVTX_POP  // stop NVTX profiling
   richardson_error(&MG_h,0,VECTOR_U);
@@ -422,6 +456,9 @@ int main(int argc, char **argv){
   #ifdef USE_HPM // IBM performance counters for BGQ...
   HPM_Print();
   #endif
+  #ifdef USE_COMM_THREAD
+  comm_thread_stop();
+  #endif
   MPI_Finalize();
   #endif
   return(0);
@@ -24,6 +24,7 @@
 #include "defines.h"
 #include "level.h"
 #include "operators.h"
+#include "solvers.h"
 #include "cuda/common.h"
 //------------------------------------------------------------------------------------------------------------------------------
 void print_communicator(int printSendRecv, int rank, int level, communicator_type *comm){
@@ -79,6 +80,20 @@ int qsortGZ(const void *a, const void*b){
 }
 
 
+int qsortGZrect(const void *a, const void*b){
+  GZ_type *gza = (GZ_type*)a;
+  GZ_type *gzb = (GZ_type*)b;
+  // MPI buffers are sorted by sendRank and recvRank (one of which is my rank)
+  if(gza->sendRank < gzb->sendRank)return(-1);
+  if(gza->sendRank > gzb->sendRank)return( 1);
+  if(gza->recvRank < gzb->recvRank)return(-1);
+  if(gza->recvRank > gzb->recvRank)return( 1);
+  // then by the box being filled (the rectangles of each receiving box are contiguous)
+  if(gza->recvBoxID < gzb->recvBoxID)return(-1);
+  if(gza->recvBoxID > gzb->recvBoxID)return( 1);
+  return(qsortGZ(a,b));
+}
+
 int qsortInt(const void *a, const void *b){
   int *ia = (int*)a;
   int *ib = (int*)b;
@@ -435,6 +450,33 @@ void append_block_to_list(blockCopy_type ** blocks, int *allocated_blocks, int *
 }
 
 
+// number of blocks append_block_to_list() will tile a dim_i x dim_j x dim_k region into
+int blocks_in_region(int dim_i, int dim_j, int dim_k, int blockcopy_tile_i, int blockcopy_tile_j, int blockcopy_tile_k){
+  if( (dim_i<=0) || (dim_j<=0) || (dim_k<=0) )return(0);
+  return( ( (dim_i+blockcopy_tile_i-1)/blockcopy_tile_i )*
+          ( (dim_j+blockcopy_tile_j-1)/blockcopy_tile_j )*
+          ( (dim_k+blockcopy_tile_k-1)/blockcopy_tile_k ) );
+}
+
+
+// size a list of blocks so that it can hold num_blocks blocks before any are appended (avoids repeatedly doubling the list with um_realloc)
+void reserve_blocks_in_list(blockCopy_type ** blocks, int *allocated_blocks, int num_blocks, int um_access_policy){
+  if(num_blocks <= *allocated_blocks)return;
+  int oldSize = *allocated_blocks;
+  if(*allocated_blocks == 0)*blocks=(blockCopy_type*) um_malloc(                 num_blocks*sizeof(blockCopy_type), um_access_policy);
+                       else *blocks=(blockCopy_type*)um_realloc((void*)(*blocks),num_blocks*sizeof(blockCopy_type), um_access_policy);
+  if(*blocks == NULL){fprintf(stderr,"realloc failed - reserve_blocks_in_list (%d -> %d)\n",oldSize,num_blocks);exit(0);}
+  *allocated_blocks = num_blocks;
+}
+
+
+// index of rank in a sorted list of unique ranks (e.g. send_ranks/recv_ranks) or -1 if absent
+int index_of_rank(int *ranks, int num_ranks, int rank){
+  int *found = (int*)bsearch(&rank,ranks,num_ranks,sizeof(int),qsortInt);
+  return( found ? (int)(found-ranks) : -1 );
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------------------------------------
 // create a mini program that traverses the domain boundary intersecting with this process's boxes
 // This includes faces, corners, and edges
@@ -492,6 +534,7 @@ void build_boundary_conditions(level_type *level, int shape){
     }
 
     // use regionIsOutside to short circuit logic and cull unnecessary regions...
+    if(ghost_zone_is_shared(level,level->my_boxes[box].global_box_id,di,dj,dk))regionIsOutside=0; // another box of the brick applies this BC
     switch(shape){
       case STENCIL_SHAPE_STAR:      if(edges[dir]||corners[dir])regionIsOutside=0;break; // star-shaped stencils don't need BC's enforced on corners or edges
       case STENCIL_SHAPE_NO_CORNERS:if(            corners[dir])regionIsOutside=0;break; // these stencils don't need BC's enforced on edges
@@ -567,6 +610,171 @@ void build_boundary_conditions(level_type *level, int shape){
   #endif
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// global id of the box displaced by (di,dj,dk) from box id... returns -1 if that is outside a non-periodic domain
+int neighbor_box_id(level_type *level, int id, int di, int dj, int dk){
+  int i = (id % level->boxes_in.i)                    + di;
+  int j = (id / level->boxes_in.i) % level->boxes_in.j + dj;
+  int k = (id /(level->boxes_in.i  * level->boxes_in.j))+ dk;
+  if(level->boundary_condition.type == BC_PERIODIC){
+    i = (i+level->boxes_in.i) % level->boxes_in.i;
+    j = (j+level->boxes_in.j) % level->boxes_in.j;
+    k = (k+level->boxes_in.k) % level->boxes_in.k;
+  }else if( (i<0) || (i>=level->boxes_in.i) || (j<0) || (j>=level->boxes_in.j) || (k<0) || (k>=level->boxes_in.k) )return(-1);
+  return(i + j*level->boxes_in.i + k*level->boxes_in.i*level->boxes_in.j);
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// When bricked, the (di,dj,dk) ghost zone region of box id is not its own if, along any of those directions, the adjacent box (no periodic wrap)
+// is owned by the same process.  That region is then either the interior of another box of the brick or part of that box's ghost zone region.
+// Such regions are skipped by the ghost zone exchange and the boundary conditions of this box.
+int ghost_zone_is_shared(level_type *level, int id, int di, int dj, int dk){
+  if(!level->brick)return(0);
+  int rank = level->rank_of_box[id];
+  int i = (id % level->boxes_in.i);
+  int j = (id / level->boxes_in.i) % level->boxes_in.j;
+  int k = (id /(level->boxes_in.i  * level->boxes_in.j));
+  if( di && (i+di>=0) && (i+di<level->boxes_in.i) && (level->rank_of_box[id+di                                     ]==rank) )return(1);
+  if( dj && (j+dj>=0) && (j+dj<level->boxes_in.j) && (level->rank_of_box[id+dj*level->boxes_in.i                   ]==rank) )return(1);
+  if( dk && (k+dk>=0) && (k+dk<level->boxes_in.k) && (level->rank_of_box[id+dk*level->boxes_in.i*level->boxes_in.j]==rank) )return(1);
+  return(0);
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// A level may be bricked if the boxes of every process form a rectangular brick and no process runs it on the GPU.
+// As this is a global property, every process can determine which ghost zone regions of every other process's boxes are shared (see above).
+int level_can_be_bricked(level_type *level){
+  int box,r,d;
+  int num_boxes = level->boxes_in.i*level->boxes_in.j*level->boxes_in.k;
+  int *bounds = (int*)malloc(7*level->num_ranks*sizeof(int)); // lo.i,lo.j,lo.k,hi.i,hi.j,hi.k,count for each rank
+  if(bounds==NULL){fprintf(stderr,"malloc failed - level_can_be_bricked\n");exit(0);}
+  for(r=0;r<level->num_ranks;r++){for(d=0;d<3;d++){bounds[7*r+d]=num_boxes;bounds[7*r+3+d]=-1;}bounds[7*r+6]=0;}
+  for(box=0;box<num_boxes;box++){
+    r = level->rank_of_box[box];if(r<0)continue;
+    int ijk[3] = {box % level->boxes_in.i, (box / level->boxes_in.i) % level->boxes_in.j, box /(level->boxes_in.i*level->boxes_in.j)};
+    for(d=0;d<3;d++){if(ijk[d]<bounds[7*r+d])bounds[7*r+d]=ijk[d];if(ijk[d]>bounds[7*r+3+d])bounds[7*r+3+d]=ijk[d];}
+    bounds[7*r+6]++;
+  }
+  int rectangular=1;
+  for(r=0;r<level->num_ranks;r++)if(bounds[7*r+6]>0){
+    int volume=1;for(d=0;d<3;d++)volume*=(bounds[7*r+3+d]-bounds[7*r+d]+1);
+    if(volume!=bounds[7*r+6])rectangular=0;
+  }
+  free(bounds);
+  int any_cuda = level->use_cuda;
+  #ifdef USE_MPI
+  MPI_Allreduce(&level->use_cuda,&any_cuda,1,MPI_INT,MPI_MAX,MPI_COMM_WORLD);
+  #endif
+  return(rectangular && !any_cuda);
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// box intersection algebra...
+// The part of box recvBoxID's ghost zone which is filled by rank sendRank is the union of up to 26 pieces (faces, edges, and corners).
+// Adjacent pieces are merged into larger rectangles until no two rectangles can be merged (e.g. a face, its 4 edges, and 4 corners become one slab).
+// Each rectangle is a contiguous brick in the MPI buffer.  The receiver unpacks it with one block while the sender packs each of its pieces into it.
+// The sender and the receiver both call this function and thus agree on the layout of the MPI buffer.
+// Returns the number of rectangles.  pieces[].rect indicates into which rectangle each piece was merged.
+typedef struct {
+  int lo[3];	// first element (relative to the first interior element of the receiving box)
+  int dim[3];	// size of the region
+  int dir;	// direction of the neighbor which fills this piece (relative to the receiver)
+  int box;	// global id of that neighbor
+  int rect;	// rectangle into which this piece was merged
+} ghostRegion_type;
+
+int build_ghost_rectangles(level_type *level, int recvBoxID, int sendRank, int *CommunicateThisDir, ghostRegion_type *pieces, int *num_pieces, ghostRegion_type *rects){
+  int di,dj,dk,a,b,d,n;
+  *num_pieces = 0;
+  for(dk=-1;dk<=1;dk++){
+  for(dj=-1;dj<=1;dj++){
+  for(di=-1;di<=1;di++){
+    int dir = 13+di+3*dj+9*dk;if(!CommunicateThisDir[dir])continue;
+    int box = neighbor_box_id(level,recvBoxID,di,dj,dk);
+    if( (box<0) || (level->rank_of_box[box]!=sendRank) )continue;
+    if(ghost_zone_is_shared(level,recvBoxID,di,dj,dk))continue; // filled by (or part of) another box of the receiver's brick
+    int delta[3] = {di,dj,dk};
+    ghostRegion_type *piece = &pieces[*num_pieces];
+    for(d=0;d<3;d++)switch(delta[d]){
+      case -1:piece->lo[d]=0-level->box_ghosts;piece->dim[d]=level->box_ghosts;break;
+      case  0:piece->lo[d]=0;                  piece->dim[d]=level->box_dim;   break;
+      case  1:piece->lo[d]=  level->box_dim;   piece->dim[d]=level->box_ghosts;break;
+    }
+    piece->dir  = dir;
+    piece->box  = box;
+    piece->rect = *num_pieces;
+    rects[*num_pieces] = *piece;
+    (*num_pieces)++;
+  }}}
+
+  // merge two rectangles whenever they match in two dimensions and abut in the third (dim[0]==0 marks a rectangle merged into another)...
+  int merged=1;
+  while(merged){
+    merged=0;
+    for(a=0;a<*num_pieces;a++)if(rects[a].dim[0]>0){
+    for(b=a+1;b<*num_pieces;b++)if(rects[b].dim[0]>0){
+      int same=0,abut=-1;
+      for(d=0;d<3;d++){
+             if( (rects[a].lo[d]==rects[b].lo[d]) && (rects[a].dim[d]==rects[b].dim[d]) )same++;
+        else if( (rects[a].lo[d]+rects[a].dim[d]==rects[b].lo[d]) || (rects[b].lo[d]+rects[b].dim[d]==rects[a].lo[d]) )abut=d;
+      }
+      if( (same==2) && (abut>=0) ){
+        if(rects[b].lo[abut]<rects[a].lo[abut])rects[a].lo[abut]=rects[b].lo[abut];
+        rects[a].dim[abut]+=rects[b].dim[abut];
+        rects[b].dim[0]=0;
+        for(n=0;n<*num_pieces;n++)if(pieces[n].rect==b)pieces[n].rect=a;
+        merged=1;
+      }
+    }}
+  }
+
+  // compact the list of rectangles...
+  int num_rects=0;
+  for(a=0;a<*num_pieces;a++)if(rects[a].dim[0]>0){
+    for(n=0;n<*num_pieces;n++)if(pieces[n].rect==a)pieces[n].rect=num_rects;
+    rects[num_rects++] = rects[a];
+  }
+  return(num_rects);
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// list the neighbors of my box (in order of increasing direction) which exist (i.e. periodic or within the domain) and are owned by some rank
+// returns the number of neighbors found (at most 26)
+int neighbors_of_box(level_type *level, int box, int *CommunicateThisDir, int *neighborDir, int *neighborBoxID){
+  int num=0;
+  int myBox_i = level->my_boxes[box].low.i / level->box_dim;
+  int myBox_j = level->my_boxes[box].low.j / level->box_dim;
+  int myBox_k = level->my_boxes[box].low.k / level->box_dim;
+  int di,dj,dk;
+  for(dk=-1;dk<=1;dk++){
+  for(dj=-1;dj<=1;dj++){
+  for(di=-1;di<=1;di++){
+    int dir = 13+di+3*dj+9*dk;if(!CommunicateThisDir[dir])continue;
+    int neighborBox_i = myBox_i + di;
+    int neighborBox_j = myBox_j + dj;
+    int neighborBox_k = myBox_k + dk;
+    if(level->boundary_condition.type == BC_PERIODIC){
+      neighborBox_i = (neighborBox_i + level->boxes_in.i) % level->boxes_in.i;
+      neighborBox_j = (neighborBox_j + level->boxes_in.j) % level->boxes_in.j;
+      neighborBox_k = (neighborBox_k + level->boxes_in.k) % level->boxes_in.k;
+    }
+    if( (neighborBox_i<0) || (neighborBox_i>=level->boxes_in.i) || 
+        (neighborBox_j<0) || (neighborBox_j>=level->boxes_in.j) || 
+        (neighborBox_k<0) || (neighborBox_k>=level->boxes_in.k) )continue; // i.e. the neighbor is not a valid box
+    int id = neighborBox_i + neighborBox_j*level->boxes_in.i + neighborBox_k*level->boxes_in.i*level->boxes_in.j;
+    if(level->rank_of_box[id] == -1)continue;
+    neighborDir[num]   = dir;
+    neighborBoxID[num] = id;
+    num++;
+  }}}
+  return(num);
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------------------------------------
 // create a mini program that packs data into MPI recv buffers, exchanges local data, and unpacks the MPI send buffers
 //   broadly speaking... 
@@ -577,6 +785,8 @@ void build_boundary_conditions(level_type *level, int shape){
 //   5. traverse my list of Boxes and create a list of ghosts that must be received
 //   6. create a list of neighbors to receive from
 //   7. allocate and populate the unpack list and allocate the recv buffers
+//   There is one MPI buffer per neighboring rank.  Within it, the ghost zone of each receiving box is sent as a few maximal rectangles
+//   (see build_ghost_rectangles()) rather than one block per face/edge/corner.  Thus, the receiver has fewer and larger unpacks.
 //
 //   thus a ghost zone exchange is
 //   1. prepost a Irecv for each MPI recv buffer (1 per neighbor)
@@ -646,55 +856,37 @@ void build_exchange_ghosts(level_type *level, int shape){
   if(ghostsToSend == NULL){fprintf(stderr,"malloc failed - build_exchange_ghosts/ghostsToSend\n");exit(0);}
   if(sendRanks    == NULL){fprintf(stderr,"malloc failed - build_exchange_ghosts/sendRanks   \n");exit(0);}
   }
+  int *numNeighbors = (int*)malloc(level->num_my_boxes*sizeof(int));
+  if( (level->num_my_boxes>0) && (numNeighbors==NULL) ){fprintf(stderr,"malloc failed - build_exchange_ghosts/numNeighbors\n");exit(0);}
+  // each box enumerates its neighbors (in parallel) into its own 26 slots...
+  #ifdef _OPENMP
+  #pragma omp parallel for private(sendBox)
+  #endif
+  for(sendBox=0;sendBox<level->num_my_boxes;sendBox++){
+    int n,dir[26],neighborBoxID[26];
+    numNeighbors[sendBox] = neighbors_of_box(level,sendBox,CommunicateThisDir,dir,neighborBoxID);
+    for(n=0;n<numNeighbors[sendBox];n++){
+      ghostsToSend[26*sendBox+n].sendRank  = level->my_rank;
+      ghostsToSend[26*sendBox+n].sendBoxID = level->my_boxes[sendBox].global_box_id;
+      ghostsToSend[26*sendBox+n].sendBox   = sendBox;
+      ghostsToSend[26*sendBox+n].sendDir   = dir[n];
+      ghostsToSend[26*sendBox+n].recvRank  = level->rank_of_box[neighborBoxID[n]];
+      ghostsToSend[26*sendBox+n].recvBoxID = neighborBoxID[n];
+      ghostsToSend[26*sendBox+n].recvBox   = level->box_of_id[neighborBoxID[n]]; // -1 if off-node
+    }
+  }
+  // compact the slots (in box order) and list the remote ranks...
   numGhosts       = 0;
   numGhostsRemote = 0;
   for(sendBox=0;sendBox<level->num_my_boxes;sendBox++){
-    int di,dj,dk;
-    for(dk=-1;dk<=1;dk++){
-    for(dj=-1;dj<=1;dj++){
-    for(di=-1;di<=1;di++){
-      int dir = 13+di+3*dj+9*dk;if(CommunicateThisDir[dir]){
-      int       myBoxID = level->my_boxes[sendBox].global_box_id;
-      int       myBox_i = level->my_boxes[sendBox].low.i / level->box_dim;
-      int       myBox_j = level->my_boxes[sendBox].low.j / level->box_dim;
-      int       myBox_k = level->my_boxes[sendBox].low.k / level->box_dim;
-      int neighborBoxID = -1;
-      if(level->boundary_condition.type == BC_PERIODIC){
-        int neighborBox_i = (  myBox_i + di + level->boxes_in.i) % level->boxes_in.i;
-        int neighborBox_j = (  myBox_j + dj + level->boxes_in.j) % level->boxes_in.j;
-        int neighborBox_k = (  myBox_k + dk + level->boxes_in.k) % level->boxes_in.k;
-            neighborBoxID =  neighborBox_i + neighborBox_j*level->boxes_in.i + neighborBox_k*level->boxes_in.i*level->boxes_in.j;
-      }else{
-        int neighborBox_i = (  myBox_i + di );
-        int neighborBox_j = (  myBox_j + dj );
-        int neighborBox_k = (  myBox_k + dk );
-        if( (neighborBox_i>=0) && (neighborBox_i<level->boxes_in.i) && 
-            (neighborBox_j>=0) && (neighborBox_j<level->boxes_in.j) && 
-            (neighborBox_k>=0) && (neighborBox_k<level->boxes_in.k) ){  // i.e. the neighbor is a valid box
-            neighborBoxID =  neighborBox_i + neighborBox_j*level->boxes_in.i + neighborBox_k*level->boxes_in.i*level->boxes_in.j;
-        }
-      }
-      if(neighborBoxID>=0){
-      if( level->rank_of_box[neighborBoxID] != -1 ){
-        ghostsToSend[numGhosts].sendRank  = level->my_rank;
-        ghostsToSend[numGhosts].sendBoxID = myBoxID;
-        ghostsToSend[numGhosts].sendBox   = sendBox;
-        ghostsToSend[numGhosts].sendDir   = dir;
-        ghostsToSend[numGhosts].recvRank  = level->rank_of_box[neighborBoxID];
-        ghostsToSend[numGhosts].recvBoxID = neighborBoxID;
-        ghostsToSend[numGhosts].recvBox   = -1;
-        if( level->rank_of_box[neighborBoxID] != level->my_rank ){
-          sendRanks[numGhostsRemote++] = level->rank_of_box[neighborBoxID];
-        }else{
-          int recvBox=0;while(level->my_boxes[recvBox].global_box_id!=neighborBoxID)recvBox++; // search my list of boxes for the appropriate recvBox index
-          ghostsToSend[numGhosts].recvBox   = recvBox;
-        }
-        numGhosts++;
-      }}
-    }}}}
+    for(n=0;n<numNeighbors[sendBox];n++){
+      ghostsToSend[numGhosts] = ghostsToSend[26*sendBox+n];
+      if(ghostsToSend[numGhosts].recvRank != level->my_rank)sendRanks[numGhostsRemote++] = ghostsToSend[numGhosts].recvRank;
+      numGhosts++;
+    }
   }
-  // sort boxes by sendRank(==my rank) then by sendBoxID... ensures the sends and receive buffers are always sorted by sendBoxID...
-  qsort(ghostsToSend,numGhosts      ,sizeof(GZ_type),qsortGZ );
+  // sort boxes by recvRank then by recvBoxID... ensures the send and receive buffers are always sorted by recvBoxID...
+  qsort(ghostsToSend,numGhosts      ,sizeof(GZ_type),qsortGZrect);
   // sort the lists of neighboring ranks and remove duplicates...
   qsort(sendRanks   ,numGhostsRemote,sizeof(    int),qsortInt);
   int numSendRanks=0;_rank=-1;for(ghost=0;ghost<numGhostsRemote;ghost++)if(sendRanks[ghost] != _rank){_rank=sendRanks[ghost];sendRanks[numSendRanks++]=sendRanks[ghost];}
@@ -717,10 +909,16 @@ void build_exchange_ghosts(level_type *level, int shape){
   level->exchange_ghosts[shape].num_blocks[1] = 0;
   level->exchange_ghosts[shape].allocated_blocks[0] = 0;
   level->exchange_ghosts[shape].allocated_blocks[1] = 0;
+  int numPackBlocks  = 0;
+  int numLocalBlocks = 0;
   for(stage=0;stage<=1;stage++){
-    // stage=0... traverse the list and calculate the buffer sizes
-    // stage=1... allocate MPI send buffers, traverse the list, and populate the unpack/local lists...
+    // stage=0... traverse the list and calculate the buffer sizes and the number of blocks
+    // stage=1... allocate MPI send buffers and the pack/local lists, traverse the list, and populate the pack/local lists...
     int neighbor;
+    if(stage==1){
+      reserve_blocks_in_list(&(level->exchange_ghosts[shape].blocks[0]),&(level->exchange_ghosts[shape].allocated_blocks[0]),numPackBlocks ,level->um_access_policy);
+      reserve_blocks_in_list(&(level->exchange_ghosts[shape].blocks[1]),&(level->exchange_ghosts[shape].allocated_blocks[1]),numLocalBlocks,level->um_access_policy);
+    }
     for(neighbor=0;neighbor<numSendRanks;neighbor++){
       if(stage==1){
 #if defined(MPI_ALLOC_PINNED)
@@ -743,6 +941,52 @@ void build_exchange_ghosts(level_type *level, int shape){
       level->exchange_ghosts[shape].send_sizes[neighbor]=0;
     }
     for(ghost=0;ghost<numGhosts;ghost++){
+      if(ghostsToSend[ghost].recvRank != level->my_rank){
+        // the first ghost sent to each remote box packs each piece of that box's ghost zone into its rectangle in the MPI send buffer
+        if( (ghost>0) && (ghostsToSend[ghost-1].recvRank==ghostsToSend[ghost].recvRank) && (ghostsToSend[ghost-1].recvBoxID==ghostsToSend[ghost].recvBoxID) )continue;
+        ghostRegion_type pieces[26],rects[26];
+        int p,r,num_pieces;
+        int num_rects = build_ghost_rectangles(level,ghostsToSend[ghost].recvBoxID,level->my_rank,CommunicateThisDir,pieces,&num_pieces,rects);
+        neighbor=index_of_rank(level->exchange_ghosts[shape].send_ranks,numSendRanks,ghostsToSend[ghost].recvRank);
+        for(r=0;r<num_rects;r++){
+          if(stage==0)for(p=0;p<num_pieces;p++)if(pieces[p].rect==r)numPackBlocks+=blocks_in_region(pieces[p].dim[0],pieces[p].dim[1],pieces[p].dim[2],BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K);
+          if(stage==1)for(p=0;p<num_pieces;p++)if(pieces[p].rect==r){
+            int di = ((pieces[p].dir % 3)  )-1; // direction of the sender relative to the receiver
+            int dj = ((pieces[p].dir % 9)/3)-1;
+            int dk = ((pieces[p].dir / 9)  )-1;
+            int sendBox = level->box_of_id[pieces[p].box];
+            append_block_to_list(&(level->exchange_ghosts[shape].blocks[0]),&(level->exchange_ghosts[shape].allocated_blocks[0]),&(level->exchange_ghosts[shape].num_blocks[0]),
+              /* dim.i         = */ pieces[p].dim[0],
+              /* dim.j         = */ pieces[p].dim[1],
+              /* dim.k         = */ pieces[p].dim[2],
+              /* read.box      = */ sendBox,
+              /* read.ptr      = */ NULL,
+              /* read.i        = */ pieces[p].lo[0] - di*level->box_dim,
+              /* read.j        = */ pieces[p].lo[1] - dj*level->box_dim,
+              /* read.k        = */ pieces[p].lo[2] - dk*level->box_dim,
+              /* read.jStride  = */ level->my_boxes[sendBox].jStride,
+              /* read.kStride  = */ level->my_boxes[sendBox].kStride,
+              /* read.scale    = */ 1,
+              /* write.box     = */ -1,
+              /* write.ptr     = */ level->exchange_ghosts[shape].send_buffers[neighbor], // NOTE, 1. count _sizes, 2. allocate _buffers, 3. populate blocks
+              /* write.i       = */ level->exchange_ghosts[shape].send_sizes[neighbor] + pieces[p].lo[0]-rects[r].lo[0], // current offset in the MPI send buffer
+              /* write.j       = */ pieces[p].lo[1]-rects[r].lo[1],
+              /* write.k       = */ pieces[p].lo[2]-rects[r].lo[2],
+              /* write.jStride = */ rects[r].dim[0],                 // piece of a contiguous rectangle
+              /* write.kStride = */ rects[r].dim[0]*rects[r].dim[1], // piece of a contiguous rectangle
+              /* write.scale   = */ 1,
+              /* blockcopy_i   = */ BLOCKCOPY_TILE_I, // default
+              /* blockcopy_j   = */ BLOCKCOPY_TILE_J, // default
+              /* blockcopy_k   = */ BLOCKCOPY_TILE_K, // default
+              /* subtype       = */ 0,
+              /* access policy = */ level->um_access_policy
+            );
+          }
+          level->exchange_ghosts[shape].send_sizes[neighbor]+=rects[r].dim[0]*rects[r].dim[1]*rects[r].dim[2];
+        }
+        continue;
+      }
+
       int  dim_i=-1, dim_j=-1, dim_k=-1;
       int send_i=-1,send_j=-1,send_k=-1;
       int recv_i=-1,recv_j=-1,recv_k=-1;
@@ -766,19 +1010,11 @@ void build_exchange_ghosts(level_type *level, int shape){
         case  0:send_k=0;                               dim_k=level->box_dim;   recv_k=0;                  break;
         case  1:send_k=level->box_dim-level->box_ghosts;dim_k=level->box_ghosts;recv_k=0-level->box_ghosts;break;
       }
+      if(ghost_zone_is_shared(level,ghostsToSend[ghost].recvBoxID,-di,-dj,-dk))continue; // no copy is necessary within a brick
  
-      // determine if this ghost requires a pack or local exchange 
-      int LocalExchange; // 0 = pack list, 1 = local exchange list
-      if(ghostsToSend[ghost].recvRank != level->my_rank){
-        LocalExchange=0; // pack
-        neighbor=0;while(level->exchange_ghosts[shape].send_ranks[neighbor] != ghostsToSend[ghost].recvRank)neighbor++;
-      }else{
-        LocalExchange=1; // local
-        neighbor=-1;
-      }
-   
-      if(stage==1){ 
-      if(LocalExchange) // append to the local exchange list...
+      // append to the local exchange list...
+      if(stage==0)numLocalBlocks+=blocks_in_region(dim_i,dim_j,dim_k,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K);
+      if(stage==1)
       append_block_to_list(&(level->exchange_ghosts[shape].blocks[1]),&(level->exchange_ghosts[shape].allocated_blocks[1]),&(level->exchange_ghosts[shape].num_blocks[1]),
         /* dim.i         = */ dim_i,
         /* dim.j         = */ dim_j,
@@ -805,34 +1041,6 @@ void build_exchange_ghosts(level_type *level, int shape){
         /* subtype       = */ 0,
         /* access policy = */ level->um_access_policy
       );
-      else // append to the MPI pack list...
-      append_block_to_list(&(level->exchange_ghosts[shape].blocks[0]),&(level->exchange_ghosts[shape].allocated_blocks[0]),&(level->exchange_ghosts[shape].num_blocks[0]),
-        /* dim.i         = */ dim_i,
-        /* dim.j         = */ dim_j,
-        /* dim.k         = */ dim_k,
-        /* read.box      = */ ghostsToSend[ghost].sendBox,
-        /* read.ptr      = */ NULL,
-        /* read.i        = */ send_i,
-        /* read.j        = */ send_j,
-        /* read.k        = */ send_k,
-        /* read.jStride  = */ level->my_boxes[ghostsToSend[ghost].sendBox].jStride,
-        /* read.kStride  = */ level->my_boxes[ghostsToSend[ghost].sendBox].kStride,
-        /* read.scale    = */ 1,
-        /* write.box     = */ -1,
-        /* write.ptr     = */ level->exchange_ghosts[shape].send_buffers[neighbor], // NOTE, 1. count _sizes, 2. allocate _buffers, 3. populate blocks
-        /* write.i       = */ level->exchange_ghosts[shape].send_sizes[neighbor], // current offset in the MPI send buffer
-        /* write.j       = */ 0,
-        /* write.k       = */ 0,
-        /* write.jStride = */ dim_i,       // contiguous block
-        /* write.kStride = */ dim_i*dim_j, // contiguous block
-        /* write.scale   = */ 1,
-        /* blockcopy_i   = */ BLOCKCOPY_TILE_I, // default
-        /* blockcopy_j   = */ BLOCKCOPY_TILE_J, // default
-        /* blockcopy_k   = */ BLOCKCOPY_TILE_K, // default
-        /* subtype       = */ 0,
-        /* access policy = */ level->um_access_policy
-      );}
-      if(neighbor>=0)level->exchange_ghosts[shape].send_sizes[neighbor]+=dim_i*dim_j*dim_k;
     } // ghost for-loop
   } // stage for-loop
 
@@ -851,50 +1059,37 @@ void build_exchange_ghosts(level_type *level, int shape){
   if(ghostsToRecv == NULL){fprintf(stderr,"malloc failed - build_exchange_ghosts/ghostsToRecv\n");exit(0);}
   if(recvRanks    == NULL){fprintf(stderr,"malloc failed - build_exchange_ghosts/recvRanks   \n");exit(0);}
   }
+  // each box enumerates its off-node neighbors (in parallel) into its own 26 slots...
+  #ifdef _OPENMP
+  #pragma omp parallel for private(recvBox)
+  #endif
+  for(recvBox=0;recvBox<level->num_my_boxes;recvBox++){
+    int n,m=0,dir[26],neighborBoxID[26];
+    int num = neighbors_of_box(level,recvBox,CommunicateThisDir,dir,neighborBoxID);
+    for(n=0;n<num;n++)if(level->rank_of_box[neighborBoxID[n]] != level->my_rank){
+      ghostsToRecv[26*recvBox+m].sendRank  = level->rank_of_box[neighborBoxID[n]];
+      ghostsToRecv[26*recvBox+m].sendBoxID = neighborBoxID[n];
+      ghostsToRecv[26*recvBox+m].sendBox   = -1;
+      ghostsToRecv[26*recvBox+m].sendDir   = 26-dir[n];
+      ghostsToRecv[26*recvBox+m].recvRank  = level->my_rank;
+      ghostsToRecv[26*recvBox+m].recvBoxID = level->my_boxes[recvBox].global_box_id;
+      ghostsToRecv[26*recvBox+m].recvBox   = recvBox;
+      m++;
+    }
+    numNeighbors[recvBox] = m;
+  }
+  // compact the slots (in box order) and list the remote ranks...
   numGhosts       = 0;
   numGhostsRemote = 0;
   for(recvBox=0;recvBox<level->num_my_boxes;recvBox++){
-    int di,dj,dk;
-    for(dk=-1;dk<=1;dk++){
-    for(dj=-1;dj<=1;dj++){
-    for(di=-1;di<=1;di++){
-      int dir = 13+di+3*dj+9*dk;if(CommunicateThisDir[dir]){
-      int       myBoxID = level->my_boxes[recvBox].global_box_id;
-      int       myBox_i = level->my_boxes[recvBox].low.i / level->box_dim;
-      int       myBox_j = level->my_boxes[recvBox].low.j / level->box_dim;
-      int       myBox_k = level->my_boxes[recvBox].low.k / level->box_dim;
-      int neighborBoxID = -1;
-      if(level->boundary_condition.type == BC_PERIODIC){
-        int neighborBox_i = (  myBox_i + di + level->boxes_in.i) % level->boxes_in.i;
-        int neighborBox_j = (  myBox_j + dj + level->boxes_in.j) % level->boxes_in.j;
-        int neighborBox_k = (  myBox_k + dk + level->boxes_in.k) % level->boxes_in.k;
-            neighborBoxID =  neighborBox_i + neighborBox_j*level->boxes_in.i + neighborBox_k*level->boxes_in.i*level->boxes_in.j;
-      }else{
-        int neighborBox_i = (  myBox_i + di );
-        int neighborBox_j = (  myBox_j + dj );
-        int neighborBox_k = (  myBox_k + dk );
-        if( (neighborBox_i>=0) && (neighborBox_i<level->boxes_in.i) && 
-            (neighborBox_j>=0) && (neighborBox_j<level->boxes_in.j) && 
-            (neighborBox_k>=0) && (neighborBox_k<level->boxes_in.k) ){  // i.e. the neighbor is a valid box
-            neighborBoxID =  neighborBox_i + neighborBox_j*level->boxes_in.i + neighborBox_k*level->boxes_in.i*level->boxes_in.j;
-        }
-      }
-      if(neighborBoxID>=0){
-      if( (level->rank_of_box[neighborBoxID] != -1) && (level->rank_of_box[neighborBoxID] != level->my_rank)  ){
-        ghostsToRecv[numGhosts].sendRank  = level->rank_of_box[neighborBoxID];
-        ghostsToRecv[numGhosts].sendBoxID = neighborBoxID;
-        ghostsToRecv[numGhosts].sendBox   = -1;
-        ghostsToRecv[numGhosts].sendDir   = 26-dir;
-        ghostsToRecv[numGhosts].recvRank  = level->my_rank;
-        ghostsToRecv[numGhosts].recvBoxID = myBoxID;
-        ghostsToRecv[numGhosts].recvBox   = recvBox;
-                     numGhosts++;
-        recvRanks[numGhostsRemote++] = level->rank_of_box[neighborBoxID];
-      }}
-    }}}}
+    for(n=0;n<numNeighbors[recvBox];n++){
+      ghostsToRecv[numGhosts] = ghostsToRecv[26*recvBox+n];
+      recvRanks[numGhostsRemote++] = ghostsToRecv[numGhosts].sendRank;
+      numGhosts++;
+    }
   }
-  // sort boxes by sendRank then by sendBoxID... ensures the recvs and receive buffers are always sorted by sendBoxID...
-  qsort(ghostsToRecv,numGhosts      ,sizeof(GZ_type),qsortGZ );
+  // sort boxes by sendRank then by recvBoxID... ensures the send and receive buffers are always sorted by recvBoxID...
+  qsort(ghostsToRecv,numGhosts      ,sizeof(GZ_type),qsortGZrect);
   // sort the lists of neighboring ranks and remove duplicates...
   qsort(recvRanks   ,numGhostsRemote,sizeof(    int),qsortInt);
   int numRecvRanks=0;_rank=-1;for(ghost=0;ghost<numGhostsRemote;ghost++)if(recvRanks[ghost] != _rank){_rank=recvRanks[ghost];recvRanks[numRecvRanks++]=recvRanks[ghost];}
@@ -914,10 +1109,12 @@ void build_exchange_ghosts(level_type *level, int shape){
   level->exchange_ghosts[shape].blocks[2] = NULL;
   level->exchange_ghosts[shape].num_blocks[2] = 0;
   level->exchange_ghosts[shape].allocated_blocks[2] = 0;
+  int numUnpackBlocks = 0;
   for(stage=0;stage<=1;stage++){
-    // stage=0... traverse the list and calculate the buffer sizes
-    // stage=1... allocate MPI recv buffers, traverse the list, and populate the unpack/local lists...
+    // stage=0... traverse the list and calculate the buffer sizes and the number of blocks
+    // stage=1... allocate MPI recv buffers and the unpack list, traverse the list, and populate the unpack list...
     int neighbor;
+    if(stage==1)reserve_blocks_in_list(&(level->exchange_ghosts[shape].blocks[2]),&(level->exchange_ghosts[shape].allocated_blocks[2]),numUnpackBlocks,level->um_access_policy);
     for(neighbor=0;neighbor<numRecvRanks;neighbor++){
       if(stage==1){
 #if defined(MPI_ALLOC_PINNED)
@@ -940,49 +1137,31 @@ void build_exchange_ghosts(level_type *level, int shape){
       level->exchange_ghosts[shape].recv_sizes[neighbor]=0;
     }
     for(ghost=0;ghost<numGhosts;ghost++){
-      int  dim_i=-1, dim_j=-1, dim_k=-1;
-    //int send_i=-1,send_j=-1,send_k=-1;
-      int recv_i=-1,recv_j=-1,recv_k=-1;
-  
-      // decode ghostsToRecv[ghost].sendDir (direction sent) into di/dj/dk 
-      int di = ((ghostsToRecv[ghost].sendDir % 3)  )-1;
-      int dj = ((ghostsToRecv[ghost].sendDir % 9)/3)-1;
-      int dk = ((ghostsToRecv[ghost].sendDir / 9)  )-1;
-      switch(di){ // direction relative to sender
-        case -1:dim_i=level->box_ghosts;recv_i=  level->box_dim;   break;
-        case  0:dim_i=level->box_dim;   recv_i=0;                  break;
-        case  1:dim_i=level->box_ghosts;recv_i=0-level->box_ghosts;break;
-      }
-      switch(dj){ // direction relative to sender
-        case -1:dim_j=level->box_ghosts;recv_j=  level->box_dim;   break;
-        case  0:dim_j=level->box_dim;   recv_j=0;                  break;
-        case  1:dim_j=level->box_ghosts;recv_j=0-level->box_ghosts;break;
-      }
-      switch(dk){ // direction relative to sender
-        case -1:dim_k=level->box_ghosts;recv_k=  level->box_dim;   break;
-        case  0:dim_k=level->box_dim;   recv_k=0;                  break;
-        case  1:dim_k=level->box_ghosts;recv_k=0-level->box_ghosts;break;
-      }
- 
-      // determine if this ghost requires a pack or local exchange 
-      neighbor=0;while(level->exchange_ghosts[shape].recv_ranks[neighbor] != ghostsToRecv[ghost].sendRank)neighbor++;
+      // the first ghost received from each rank into each of my boxes unpacks each of the rectangles that rank sent to that box
+      if( (ghost>0) && (ghostsToRecv[ghost-1].sendRank==ghostsToRecv[ghost].sendRank) && (ghostsToRecv[ghost-1].recvBoxID==ghostsToRecv[ghost].recvBoxID) )continue;
+      ghostRegion_type pieces[26],rects[26];
+      int r,num_pieces;
+      int num_rects = build_ghost_rectangles(level,ghostsToRecv[ghost].recvBoxID,ghostsToRecv[ghost].sendRank,CommunicateThisDir,pieces,&num_pieces,rects);
+      neighbor=index_of_rank(level->exchange_ghosts[shape].recv_ranks,numRecvRanks,ghostsToRecv[ghost].sendRank);
+      for(r=0;r<num_rects;r++){
+      if(stage==0)numUnpackBlocks+=blocks_in_region(rects[r].dim[0],rects[r].dim[1],rects[r].dim[2],BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K);
       if(stage==1)append_block_to_list(&(level->exchange_ghosts[shape].blocks[2]),&(level->exchange_ghosts[shape].allocated_blocks[2]),&(level->exchange_ghosts[shape].num_blocks[2]),
-      /*dim.i         = */ dim_i,
-      /*dim.j         = */ dim_j,
-      /*dim.k         = */ dim_k,
+      /*dim.i         = */ rects[r].dim[0],
+      /*dim.j         = */ rects[r].dim[1],
+      /*dim.k         = */ rects[r].dim[2],
       /*read.box      = */ -1,
       /*read.ptr      = */ level->exchange_ghosts[shape].recv_buffers[neighbor], // NOTE, 1. count _sizes, 2. allocate _buffers, 3. populate blocks
       /*read.i        = */ level->exchange_ghosts[shape].recv_sizes[neighbor], // current offset in the MPI recv buffer
       /*read.j        = */ 0,
       /*read.k        = */ 0,
-      /*read.jStride  = */ dim_i,       // contiguous block
-      /*read.kStride  = */ dim_i*dim_j, // contiguous block
+      /*read.jStride  = */ rects[r].dim[0],                 // contiguous rectangle
+      /*read.kStride  = */ rects[r].dim[0]*rects[r].dim[1], // contiguous rectangle
       /*read.scale    = */ 1,
       /*write.box     = */ ghostsToRecv[ghost].recvBox,
       /*write.ptr     = */ NULL,
-      /*write.i       = */ recv_i,
-      /*write.j       = */ recv_j,
-      /*write.k       = */ recv_k,
+      /*write.i       = */ rects[r].lo[0],
+      /*write.j       = */ rects[r].lo[1],
+      /*write.k       = */ rects[r].lo[2],
       /*write.jStride = */ level->my_boxes[ghostsToRecv[ghost].recvBox].jStride,
       /*write.kStride = */ level->my_boxes[ghostsToRecv[ghost].recvBox].kStride,
       /*write.scale   = */ 1,
@@ -992,7 +1171,8 @@ void build_exchange_ghosts(level_type *level, int shape){
       /* subtype      = */ 0,
       /* access policy= */ level->um_access_policy
       );
-      if(neighbor>=0)level->exchange_ghosts[shape].recv_sizes[neighbor]+=dim_i*dim_j*dim_k;
+      level->exchange_ghosts[shape].recv_sizes[neighbor]+=rects[r].dim[0]*rects[r].dim[1]*rects[r].dim[2];
+      }
     } // ghost for-loop
   } // stage for-loop
 
@@ -1001,6 +1181,7 @@ void build_exchange_ghosts(level_type *level, int shape){
   // free temporary storage...
   free(ghostsToRecv);
   free(recvRanks);
+  free(numNeighbors);
 
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1021,9 +1202,227 @@ void build_exchange_ghosts(level_type *level, int shape){
   qsort(level->exchange_ghosts[shape].blocks[1],level->exchange_ghosts[shape].num_blocks[1],sizeof(blockCopy_type),qsortBlock);
   qsort(level->exchange_ghosts[shape].blocks[2],level->exchange_ghosts[shape].num_blocks[2],sizeof(blockCopy_type),qsortBlock);
   #endif
+  #ifdef USE_MPI_DATATYPES
+  build_zero_copy(level,&level->exchange_ghosts[shape]);
+  #endif
+  group_blocks_by_buffer(&level->exchange_ghosts[shape]);
 }
 
 
+#ifdef USE_MPI_DATATYPES
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// Zero-copy ghost zone exchanges (-DUSE_MPI_DATATYPES)
+// Rectangles whose pencils are long (e.g. k-faces and j-slabs) are not packed into the MPI buffers.  Rather, they are described
+// by an MPI derived datatype relative to the start of a vector (all vectors share the same layout) which MPI sends directly from
+// the boxes or receives directly into the ghost zones.  The remaining (strided) rectangles are still staged through the buffers.
+// The decision only depends on the buffer's layout (the pencil length of each rectangle) on which the sender and receiver agree.
+// Both sides visit the elements in buffer order.  Thus, the datatypes match and the compacted buffer offsets remain consistent.
+#ifndef MPI_DATATYPE_MIN_RUN
+#define MPI_DATATYPE_MIN_RUN 16 // minimum length (in doubles) of a rectangle's pencils for it to be sent via a datatype
+#endif
+
+
+// split the pack (send) or unpack (!send) list into blocks described by a datatype per neighbor and blocks staged through the buffers
+MPI_Datatype * build_zero_copy_types(level_type *level, communicator_type *comm, int send){
+  int list             = send ? 0                  : 2;
+  int num_buffers      = send ? comm->num_sends    : comm->num_recvs;
+  double **buffers     = send ? comm->send_buffers : comm->recv_buffers;
+  int *sizes           = send ? comm->send_sizes   : comm->recv_sizes;
+  blockCopy_type *blocks = comm->blocks[list];
+  int num_blocks       = comm->num_blocks[list];
+  int b,n,i,j,k;
+
+  MPI_Datatype *types = (MPI_Datatype*)malloc(num_buffers*sizeof(MPI_Datatype));
+  char      *eligible = (char        *)malloc(num_blocks *sizeof(char        ));
+  if( (num_buffers>0) && (types==NULL) ){fprintf(stderr,"malloc failed - build_zero_copy_types\n");exit(0);}
+  if( (num_blocks >0) && (eligible==NULL) ){fprintf(stderr,"malloc failed - build_zero_copy_types\n");exit(0);}
+  for(b=0;b<num_blocks;b++)eligible[b] = ( (send?blocks[b].write.jStride:blocks[b].read.jStride) >= MPI_DATATYPE_MIN_RUN );
+
+  for(n=0;n<num_buffers;n++){
+    // the displacement (in bytes from the start of the vector) of each element of the buffer sent via the datatype (-1 if staged)...
+    int size = sizes[n];
+    MPI_Aint *displacement = (MPI_Aint*)malloc(size*sizeof(MPI_Aint));
+    int      *skipped      = (int     *)malloc((size+1)*sizeof(int));
+    if( (displacement==NULL) || (skipped==NULL) ){fprintf(stderr,"malloc failed - build_zero_copy_types\n");exit(0);}
+    int p;for(p=0;p<size;p++)displacement[p]=-1;
+    for(b=0;b<num_blocks;b++)if(eligible[b]){
+      blockCopy_type *block = &blocks[b];
+      if( (send?block->write.ptr:block->read.ptr) != buffers[n] )continue;
+      struct {int box,i,j,k,jStride,kStride;} grid,buf;
+      if(send){grid.box=block->read.box; grid.i=block->read.i; grid.j=block->read.j; grid.k=block->read.k;
+                buf.i=block->write.i;buf.j=block->write.j;buf.k=block->write.k;buf.jStride=block->write.jStride;buf.kStride=block->write.kStride;}
+          else{grid.box=block->write.box;grid.i=block->write.i;grid.j=block->write.j;grid.k=block->write.k;
+                buf.i=block->read.i; buf.j=block->read.j; buf.k=block->read.k; buf.jStride=block->read.jStride; buf.kStride=block->read.kStride;}
+      grid.jStride = level->my_boxes[grid.box].jStride;
+      grid.kStride = level->my_boxes[grid.box].kStride;
+      MPI_Aint base = (MPI_Aint)(level->my_boxes[grid.box].vectors[0]-level->vectors[0]) + level->box_ghosts*(1+grid.jStride+grid.kStride);
+      for(k=0;k<block->dim.k;k++){
+      for(j=0;j<block->dim.j;j++){
+      for(i=0;i<block->dim.i;i++){
+        displacement[(i+buf.i) + (j+buf.j)*buf.jStride + (k+buf.k)*buf.kStride] = (base + (i+grid.i) + (j+grid.j)*grid.jStride + (k+grid.k)*grid.kStride)*sizeof(double);
+      }}}
+    }
+
+    // one run per pencil (merged when contiguous) in buffer order.  skipped[p] counts the elements before p that are no longer staged...
+    int runs=0;
+    for(p=0;p<size;p++)if(displacement[p]>=0)runs++;
+    int      *lengths       = (int     *)malloc(runs*sizeof(int     ));
+    MPI_Aint *displacements = (MPI_Aint*)malloc(runs*sizeof(MPI_Aint));
+    if( (runs>0) && ((lengths==NULL)||(displacements==NULL)) ){fprintf(stderr,"malloc failed - build_zero_copy_types\n");exit(0);}
+    int r=0;
+    skipped[0]=0;
+    for(p=0;p<size;p++){
+      skipped[p+1] = skipped[p];
+      if(displacement[p]<0)continue;
+      skipped[p+1]++;
+      if( (r>0) && (displacements[r-1]+lengths[r-1]*sizeof(double)==displacement[p]) ){lengths[r-1]++;}
+      else{displacements[r]=displacement[p];lengths[r]=1;r++;}
+    }
+    types[n] = MPI_DATATYPE_NULL;
+    if(r>0){
+      MPI_Type_create_hindexed(r,lengths,displacements,MPI_DOUBLE,&types[n]);
+      MPI_Type_commit(&types[n]);
+    }
+    sizes[n] = size - skipped[size];
+
+    // shift the staged blocks down by the number of elements now sent via the datatype (rectangles are either entirely staged or not)...
+    for(b=0;b<num_blocks;b++)if(!eligible[b]){
+      blockCopy_type *block = &blocks[b];
+      if( (send?block->write.ptr:block->read.ptr) != buffers[n] )continue;
+      if(send)block->write.i -= skipped[block->write.i + block->write.j*block->write.jStride + block->write.k*block->write.kStride];
+         else block->read.i  -= skipped[block->read.i  + block->read.j *block->read.jStride  + block->read.k *block->read.kStride ];
+    }
+    free(lengths);
+    free(displacements);
+    free(displacement);
+    free(skipped);
+  }
+
+  // move the zero-copy blocks to zc_blocks[list] (they are no longer packed/unpacked, but are kept for bookkeeping)...
+  comm->num_zc_blocks[list] = 0;
+  comm->zc_blocks[list] = (blockCopy_type*)malloc(num_blocks*sizeof(blockCopy_type));
+  if( (num_blocks>0) && (comm->zc_blocks[list]==NULL) ){fprintf(stderr,"malloc failed - build_zero_copy_types\n");exit(0);}
+  int num_staged=0;
+  for(b=0;b<num_blocks;b++){
+    if(eligible[b])comm->zc_blocks[list][comm->num_zc_blocks[list]++] = blocks[b];
+              else blocks[num_staged++] = blocks[b];
+  }
+  comm->num_blocks[list] = num_staged;
+
+  free(eligible);
+  return(types);
+}
+
+
+void build_zero_copy(level_type *level, communicator_type *comm){
+  comm->send_types   = NULL;
+  comm->recv_types   = NULL;
+  comm->zc_requests  = NULL;
+  comm->zc_blocks[0] = NULL;comm->num_zc_blocks[0] = 0;
+  comm->zc_blocks[1] = NULL;comm->num_zc_blocks[1] = 0;
+  comm->zc_blocks[2] = NULL;comm->num_zc_blocks[2] = 0;
+  // the GPU path packs on the device.  Every rank must make the same decision.
+  int any_cuda = level->use_cuda;
+  MPI_Allreduce(&level->use_cuda,&any_cuda,1,MPI_INT,MPI_MAX,MPI_COMM_WORLD);
+  if(any_cuda)return;
+  comm->send_types  = build_zero_copy_types(level,comm,1);
+  comm->recv_types  = build_zero_copy_types(level,comm,0);
+  comm->zc_requests = (MPI_Request*)malloc((comm->num_sends+comm->num_recvs)*sizeof(MPI_Request));
+  if( ((comm->num_sends+comm->num_recvs)>0) && (comm->zc_requests==NULL) ){fprintf(stderr,"malloc failed - build_zero_copy\n");exit(0);}
+}
+#endif
+
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// stable sort of a pack (use_write) or unpack list by the MPI buffer each block writes to/reads from
+// returns a list of num_buffers+1 offsets such that blocks[start[n]..start[n+1]-1] reference buffers[n]
+int * sort_blocks_by_buffer(blockCopy_type *blocks, int num_blocks, int use_write, double **buffers, int num_buffers){
+  int b,n;
+  int *start = (int*)malloc((num_buffers+1)*sizeof(int));
+  int *next  = (int*)malloc((num_buffers+1)*sizeof(int));
+  int *which = (int*)malloc(num_blocks*sizeof(int));
+  blockCopy_type *copy = (blockCopy_type*)malloc(num_blocks*sizeof(blockCopy_type));
+  if( (start==NULL) || (next==NULL) || ((num_blocks>0)&&((which==NULL)||(copy==NULL))) ){fprintf(stderr,"malloc failed - sort_blocks_by_buffer\n");exit(0);}
+
+  for(n=0;n<=num_buffers;n++)start[n]=0;
+  for(b=0;b<num_blocks;b++){
+    double *ptr = use_write ? blocks[b].write.ptr : blocks[b].read.ptr;
+    n=0;while( (n<num_buffers) && (buffers[n]!=ptr) )n++;
+    if(n==num_buffers){fprintf(stderr,"block %d does not reference an MPI buffer - sort_blocks_by_buffer\n",b);exit(0);}
+    which[b]=n;
+    start[n+1]++;
+  }
+  for(n=0;n<num_buffers;n++)start[n+1]+=start[n];
+  for(n=0;n<=num_buffers;n++)next[n]=start[n];
+  if(num_blocks>0)memcpy(copy,blocks,num_blocks*sizeof(blockCopy_type));
+  for(b=0;b<num_blocks;b++)blocks[next[which[b]]++] = copy[b];
+
+  free(copy);
+  free(which);
+  free(next);
+  return(start);
+}
+
+
+// group the pack and unpack lists of a communicator by neighbor so that each Isend may be posted as soon as its own buffer
+// is packed and each receive buffer may be unpacked as soon as it arrives (rather than after MPI_Waitall)
+void group_blocks_by_buffer(communicator_type *comm){
+  comm->pack_start   = NULL;
+  comm->unpack_start = NULL;
+  if(comm->num_sends>0)comm->pack_start   = sort_blocks_by_buffer(comm->blocks[0],comm->num_blocks[0],1,comm->send_buffers,comm->num_sends);
+  if(comm->num_recvs>0)comm->unpack_start = sort_blocks_by_buffer(comm->blocks[2],comm->num_blocks[2],0,comm->recv_buffers,comm->num_recvs);
+}
+
+
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// conflict model for host stencil sweeps (-DUSE_BOX_PADDING)
+// a sweep streams through x and beta_i/j/k at each pencil within radius (|dj|+|dk|<=radius) and through rhs, alpha, and Dinv at ijk.
+// As i advances, these streams advance together.  Thus, their relative cache sets are fixed by jStride, kStride, and the offset between vectors.
+// returns the number of streams in excess of the associativity of their set
+int box_layout_conflicts(int jStride, int kStride, uint64_t vector_offset, int radius){
+  int count[BOX_PAD_CACHE_SETS];
+  int s,v,dj,dk,conflicts=0;
+  for(s=0;s<BOX_PAD_CACHE_SETS;s++)count[s]=0;
+  for(v=0;v<7;v++){
+    int r = (v<4) ? radius : 0;
+    for(dk=-r;dk<=r;dk++){
+    for(dj=-r;dj<=r;dj++){
+      if(abs(dj)+abs(dk)>r)continue;
+      uint64_t offset = (uint64_t)v*vector_offset + (uint64_t)(radius+dj)*jStride + (uint64_t)(radius+dk)*kStride;
+      count[ (offset*sizeof(double)/BOX_PAD_CACHE_LINE) % BOX_PAD_CACHE_SETS ]++;
+    }}
+  }
+  for(s=0;s<BOX_PAD_CACHE_SETS;s++)if(count[s]>BOX_PAD_CACHE_WAYS)conflicts+=count[s]-BOX_PAD_CACHE_WAYS;
+  return(conflicts);
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// VECTOR_VALID is never allocated and constant-coefficient host levels have no ALPHA or BETA_* vectors (their pointers are NULL)
+int vector_is_allocated(level_type *level, int id){
+  if(id==VECTOR_VALID)return(0);
+  if( !level->constant_coefficients || level->use_cuda )return(1);
+  return( (id<VECTOR_ALPHA) || (id>VECTOR_BETA_K) );
+}
+
+
+// a level found to have constant coefficients (after its vectors were created) releases its coefficient vectors
+// NOTE, vectors carved from a bulk allocation (VECTOR_MALLOC_BULK or USE_BOX_PADDING) are merely orphaned
+void release_coefficient_vectors(level_type *level){
+  int c,box;
+  for(c=0;c<level->numVectors;c++)if(level->vectors[c] && !vector_is_allocated(level,c)){
+    if(level->vectors_base==NULL)um_free(level->vectors[c], level->um_access_policy);
+    level->vectors[c] = NULL;
+    for(box=0;box<level->num_my_boxes;box++)level->my_boxes[box].vectors[c] = NULL;
+  }
+  if(level->coefficients){ // packed copies (-DUSE_PACKED_COEFFICIENTS) are no longer needed either
+    um_free(level->coefficients, level->um_access_policy);
+    level->coefficients = NULL;
+    for(box=0;box<level->num_my_boxes;box++)level->my_boxes[box].coefficients = NULL;
+  }
+}
+
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------
 // create the pointers in level_type to the contiguous vector FP data (useful for bulk copies to/from accelerators)
@@ -1032,20 +1431,75 @@ void build_exchange_ghosts(level_type *level, int shape){
 void create_vectors(level_type *level, int numVectors){
   if(numVectors <= level->numVectors)return; // already have enough space
   double          * old_vectors_base = level->vectors_base; // save a pointer to the originally allocated data for subsequent free()
-  double               * old_vector0 = NULL;
-  if(level->numVectors>0)old_vector0 = level->vectors[0];   // save a pointer to old FP data to copy
 
 
-  // calculate the size of each box...
-  level->box_jStride =                    (level->box_dim+2*level->box_ghosts);while(level->box_jStride % BOX_ALIGN_JSTRIDE)level->box_jStride++; // pencil
-  level->box_kStride = level->box_jStride*(level->box_dim+2*level->box_ghosts);while(level->box_kStride % BOX_ALIGN_KSTRIDE)level->box_kStride++; // plane
-  level->box_volume  = level->box_kStride*(level->box_dim+2*level->box_ghosts);while(level->box_volume  % BOX_ALIGN_VOLUME )level->box_volume++;  // volume
+  // calculate the size of each box (or of the brick of boxes)...
+  int box,i,j,k;
+  struct {int i, j, k;}brick_lo={0,0,0},brick_dim={1,1,1};
+  if(level->brick && (level->num_my_boxes>0)){
+    struct {int i, j, k;}brick_hi={0,0,0};
+    brick_lo.i=brick_lo.j=brick_lo.k=level->boxes_in.i*level->boxes_in.j*level->boxes_in.k;
+    for(box=0;box<level->boxes_in.i*level->boxes_in.j*level->boxes_in.k;box++)if(level->rank_of_box[box]==level->my_rank){
+      i = box % level->boxes_in.i;
+      j = (box / level->boxes_in.i) % level->boxes_in.j;
+      k = box /(level->boxes_in.i*level->boxes_in.j);
+      if(i<brick_lo.i)brick_lo.i=i;
+      if(i>brick_hi.i)brick_hi.i=i;
+      if(j<brick_lo.j)brick_lo.j=j;
+      if(j>brick_hi.j)brick_hi.j=j;
+      if(k<brick_lo.k)brick_lo.k=k;
+      if(k>brick_hi.k)brick_hi.k=k;
+    }
+    brick_dim.i = brick_hi.i-brick_lo.i+1;
+    brick_dim.j = brick_hi.j-brick_lo.j+1;
+    brick_dim.k = brick_hi.k-brick_lo.k+1;
+  }
+  int planes = brick_dim.k*level->box_dim+2*level->box_ghosts;
+  level->box_jStride =                    (brick_dim.i*level->box_dim+2*level->box_ghosts);while(level->box_jStride % BOX_ALIGN_JSTRIDE)level->box_jStride++; // pencil
+  level->box_kStride = level->box_jStride*(brick_dim.j*level->box_dim+2*level->box_ghosts);while(level->box_kStride % BOX_ALIGN_KSTRIDE)level->box_kStride++; // plane
+  level->box_volume  = level->box_kStride*planes;while(level->box_volume  % BOX_ALIGN_VOLUME )level->box_volume++;  // volume
+  uint64_t vector_volume = level->brick ? (uint64_t)level->box_volume : (uint64_t)level->num_my_boxes*level->box_volume; // size of each vector
+
+  #ifdef VECTOR_MALLOC_BULK
+  int malloc_bulk = 1;
+  #else
+  int malloc_bulk = 0;
+  #endif
+
+  // on the host, search for the k-stride and vector offset padding that minimizes modeled conflict misses...
+  #ifdef USE_BOX_PADDING
+  if(!level->use_cuda){
+    int pk,pv,base_kStride=level->box_kStride;
+    level->padding.unpadded_conflicts = box_layout_conflicts(level->box_jStride,base_kStride,vector_volume,level->box_ghosts);
+    level->padding.conflicts = level->padding.unpadded_conflicts;
+    level->padding.kStride   = 0;
+    level->padding.vector    = 0;
+    for(pk=0;pk<=BOX_PAD_MAX;pk++){
+    for(pv=0;pv<=BOX_PAD_MAX;pv++){
+      int kStride = base_kStride + pk*BOX_ALIGN_KSTRIDE;
+      int  volume = kStride*planes;while(volume % BOX_ALIGN_VOLUME)volume++;
+      uint64_t vector_offset = (level->brick ? (uint64_t)volume : (uint64_t)level->num_my_boxes*volume) + pv*BOX_ALIGN_VOLUME;
+      int conflicts = box_layout_conflicts(level->box_jStride,kStride,vector_offset,level->box_ghosts);
+      if(conflicts<level->padding.conflicts){ // ties favor less padding
+        level->padding.conflicts = conflicts;
+        level->padding.kStride   = pk*BOX_ALIGN_KSTRIDE;
+        level->padding.vector    = pv*BOX_ALIGN_VOLUME;
+      }
+    }}
+    level->box_kStride = base_kStride + level->padding.kStride;
+    level->box_volume  = level->box_kStride*planes;while(level->box_volume  % BOX_ALIGN_VOLUME )level->box_volume++;
+    vector_volume = level->brick ? (uint64_t)level->box_volume : (uint64_t)level->num_my_boxes*level->box_volume;
+    malloc_bulk = 1; // the offset between vectors can only be controlled within one allocation
+  }
+  #endif
+  uint64_t vector_stride = vector_volume + level->padding.vector; // offset between vectors in a bulk allocation
+  uint64_t c,num_allocated=0;
+  for(c=0;c<numVectors;c++)if(vector_is_allocated(level,c))num_allocated++;
 
 
-  //#define VECTOR_MALLOC_BULK
-  #ifdef  VECTOR_MALLOC_BULK
-    // allocate one aligned, double-precision array and divide it among vectors...
-    uint64_t malloc_size = (uint64_t)numVectors*level->num_my_boxes*level->box_volume*sizeof(double) + 4096;
+  if(malloc_bulk){
+    // allocate one aligned, double-precision array and divide it among the allocated vectors...
+    uint64_t malloc_size = num_allocated*vector_stride*sizeof(double) + 4096;
     level->vectors_base = (double*)um_malloc(malloc_size, level->um_access_policy);
     if((numVectors>0)&&(level->vectors_base==NULL)){fprintf(stderr,"malloc failed - level->vectors_base\n");exit(0);}
     double * tmpbuf = level->vectors_base;
@@ -1054,40 +1508,42 @@ void create_vectors(level_type *level, int numVectors){
     #ifdef _OPENMP
     #pragma omp parallel for
     #endif
-    for(ofs=0;ofs<(uint64_t)numVectors*level->num_my_boxes*level->box_volume;ofs++){tmpbuf[ofs]=0.0;} // Faster in MPI+OpenMP environments, but not NUMA-aware
-    // if there is existing FP data... copy it, then free old data and pointer array
-    if(level->numVectors>0){
-      memcpy(tmpbuf,old_vector0,(uint64_t)level->numVectors*level->num_my_boxes*level->box_volume*sizeof(double)); // FIX... omp thread ???
-      if(old_vectors_base)um_free(old_vectors_base, level->um_access_policy); // free old data...
-    }
+    for(ofs=0;ofs<num_allocated*vector_stride;ofs++){tmpbuf[ofs]=0.0;} // Faster in MPI+OpenMP environments, but not NUMA-aware
     // allocate an array of pointers which point to the union of boxes for each vector
     // NOTE, this requires just one copyin per vector to an accelerator rather than requiring one copyin per box per vector
-    if(level->numVectors>0)um_free(level->vectors, level->um_access_policy); // free any previously allocated vector array
+    double ** old_vectors = level->vectors;
     level->vectors = (double **)um_malloc(numVectors*sizeof(double*), level->um_access_policy);
     if((numVectors>0)&&(level->vectors==NULL)){fprintf(stderr,"malloc failed - level->vectors\n");exit(0);}
-    uint64_t c;for(c=0;c<numVectors;c++){level->vectors[c] = tmpbuf + (uint64_t)c*level->num_my_boxes*level->box_volume;}
-  #else
+    uint64_t slot=0;
+    for(c=0;c<numVectors;c++){level->vectors[c] = vector_is_allocated(level,c) ? tmpbuf + (slot++)*vector_stride : NULL;}
+    // if there is existing FP data... copy it, then free old data and pointer array
+    if(level->numVectors>0){
+      for(c=0;c<level->numVectors;c++)if(old_vectors[c] && level->vectors[c])memcpy(level->vectors[c],old_vectors[c],vector_volume*sizeof(double)); // FIX... omp thread ???
+      if(old_vectors_base)um_free(old_vectors_base, level->um_access_policy); // free old data...
+      um_free(old_vectors, level->um_access_policy); // free any previously allocated vector array
+    }
+  }else{
     // allocate vectors individually (simple, but may cause conflict misses)
     double ** old_vectors = level->vectors;
     level->vectors = (double **)um_malloc(numVectors*sizeof(double*), level->um_access_policy);
     cudaDeviceSynchronize();
-    uint64_t c;
     for(c=                0;c<level->numVectors;c++){level->vectors[c] = old_vectors[c];}
     for(c=level->numVectors;c<       numVectors;c++){
-      level->vectors[c] = (double*)um_malloc((uint64_t)level->num_my_boxes*level->box_volume*sizeof(double), level->um_access_policy);
+      level->vectors[c] = NULL;
+      if(!vector_is_allocated(level,c))continue;
+      level->vectors[c] = (double*)um_malloc(vector_volume*sizeof(double), level->um_access_policy);
       uint64_t ofs;
       #ifdef _OPENMP
       #pragma omp parallel for
       #endif
-      for(ofs=0;ofs<(uint64_t)level->num_my_boxes*level->box_volume;ofs++){level->vectors[c][ofs]=0.0;} // Faster in MPI+OpenMP environments, but not NUMA-aware
+      for(ofs=0;ofs<vector_volume;ofs++){level->vectors[c][ofs]=0.0;} // Faster in MPI+OpenMP environments, but not NUMA-aware
     }
     um_free(old_vectors, level->um_access_policy);
-  #endif
+  }
 
 
   // build the list of boxes...
-  int box=0;
-  int i,j,k;
+  box=0;
   for(k=0;k<level->boxes_in.k;k++){
   for(j=0;j<level->boxes_in.j;j++){
   for(i=0;i<level->boxes_in.i;i++){
@@ -1098,7 +1554,10 @@ void create_vectors(level_type *level, int numVectors){
       if(level->numVectors>0)um_free(level->my_boxes[box].vectors, level->um_access_policy); // free previously allocated vector array
       level->my_boxes[box].vectors = (double **)um_malloc(numVectors*sizeof(double*), level->um_access_policy);
       if((numVectors>0)&&(level->my_boxes[box].vectors==NULL)){fprintf(stderr,"malloc failed - level->my_boxes[box].vectors\n");exit(0);}
-      uint64_t c;for(c=0;c<numVectors;c++){level->my_boxes[box].vectors[c] = level->vectors[c] + (uint64_t)box*level->box_volume;}
+      uint64_t offset = (uint64_t)box*level->box_volume;
+      if(level->brick)offset = (uint64_t)level->box_dim*( (i-brick_lo.i) + (j-brick_lo.j)*level->box_jStride + (k-brick_lo.k)*level->box_kStride ); // box's view of the brick
+      uint64_t c;for(c=0;c<numVectors;c++){level->my_boxes[box].vectors[c] = level->vectors[c] ? level->vectors[c] + offset : NULL;}
+      level->my_boxes[box].coefficients = level->coefficients ? level->coefficients + PACKED_COEFS*offset : NULL;
       level->my_boxes[box].numVectors = numVectors;
       level->my_boxes[box].dim        = level->box_dim;
       level->my_boxes[box].ghosts     = level->box_ghosts;
@@ -1109,6 +1568,7 @@ void create_vectors(level_type *level, int numVectors){
       level->my_boxes[box].low.j      = j*level->box_dim;
       level->my_boxes[box].low.k      = k*level->box_dim;
       level->my_boxes[box].global_box_id = b;
+      level->box_of_id[b]                = box;
       box++;
   }}}}
 
@@ -1117,18 +1577,87 @@ void create_vectors(level_type *level, int numVectors){
 }
 
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// (re)build the list of blocks that flattens this process's boxes into tiles of (at most) tile_i x tile_j x tile_k cells
+// previously allocated storage is reused.  Used by create_level() and by the tile autotuner in MGBuild()
+void build_my_blocks(level_type *level, int tile_i, int tile_j, int tile_k){
+  int box;
+  level->num_my_blocks = 0;
+  level->tile.i = tile_i;
+  level->tile.j = tile_j;
+  level->tile.k = tile_k;
+  for(box=0;box<level->num_my_boxes;box++)level->num_my_blocks += blocks_in_region(level->my_boxes[box].dim,level->my_boxes[box].dim,level->my_boxes[box].dim,tile_i,tile_j,tile_k);
+  reserve_blocks_in_list(&(level->my_blocks),&(level->allocated_blocks),level->num_my_blocks,level->um_access_policy);
+  level->num_my_blocks = 0;
+  for(box=0;box<level->num_my_boxes;box++){
+    append_block_to_list(&(level->my_blocks),&(level->allocated_blocks),&(level->num_my_blocks),
+      /* dim.i         = */ level->my_boxes[box].dim,
+      /* dim.j         = */ level->my_boxes[box].dim,
+      /* dim.k         = */ level->my_boxes[box].dim,
+      /* read.box      = */ box,
+      /* read.ptr      = */ NULL,
+      /* read.i        = */ 0,
+      /* read.j        = */ 0,
+      /* read.k        = */ 0,
+      /* read.jStride  = */ level->my_boxes[box].jStride,
+      /* read.kStride  = */ level->my_boxes[box].kStride,
+      /* read.scale    = */ 1,
+      /* write.box     = */ box,
+      /* write.ptr     = */ NULL,
+      /* write.i       = */ 0,
+      /* write.j       = */ 0,
+      /* write.k       = */ 0,
+      /* write.jStride = */ level->my_boxes[box].jStride,
+      /* write.kStride = */ level->my_boxes[box].kStride,
+      /* write.scale   = */ 1,
+      /* blockcopy_i   = */ tile_i,
+      /* blockcopy_j   = */ tile_j,
+      /* blockcopy_k   = */ tile_k,
+      /* subtype       = */ 0,
+      /* access policy = */ level->um_access_policy
+    );
+  }
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------
+// Coarse levels (e.g. after agglomeration to one box per process) may not produce enough blocks to keep all threads busy when threading across blocks.
+// In that case, thread within each box by successively halving the k and j tile sizes (i.e. the blocked equivalent of the old collapse(2) PRAGMA_THREAD_WITHIN_A_BOX).
+// Blocks are never made smaller than MIN_CELLS_PER_BLOCK as the OpenMP overhead would then exceed the work per block.
+#ifndef MIN_CELLS_PER_BLOCK
+#define MIN_CELLS_PER_BLOCK 64
+#endif
+void thread_within_boxes(level_type *level){
+  if(level->use_cuda)return; // the CUDA kernels are compiled for BLOCKCOPY_TILE_*
+  if(level->num_threads<=1)return;
+  int tile_i = (level->tile.i<level->box_dim) ? level->tile.i : level->box_dim;
+  int tile_j = (level->tile.j<level->box_dim) ? level->tile.j : level->box_dim;
+  int tile_k = (level->tile.k<level->box_dim) ? level->tile.k : level->box_dim;
+  while(level->num_my_blocks < level->num_threads){
+         if( (tile_k>=tile_j) && (tile_k>1) )tile_k=(tile_k+1)/2;
+    else if(                     (tile_j>1) )tile_j=(tile_j+1)/2;
+    else break;
+    if(tile_i*tile_j*tile_k < MIN_CELLS_PER_BLOCK)break;
+    build_my_blocks(level,tile_i,tile_j,tile_k);
+  }
+}
+
+
 //---------------------------------------------------------------------------------------------------------------------------------------------------
 // create a level by populating the basic data structure, distribute boxes within the level among processes, allocate memory, and create any auxilliaries
-// box_ghosts must be >= stencil_get_radius()
+// box_ghosts must be >= stencil_get_radius() (or 1 for coarse levels that will use the operator's 2nd order variant)
 // numVectors represents an estimate of the number of vectors needed in this level.  Additional vectors can be added via subsequent calls to create_vectors()
-void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts, int numVectors, int domain_boundary_condition, int my_rank, int num_ranks, level_type *parent_level){
+// the level is a (boxes_in_i x boxes_in_j x boxes_in_k) grid of box_dim^3 boxes and thus need not be cubical
+void create_level(level_type *level, int boxes_in_i, int boxes_in_j, int boxes_in_k, int box_dim, int box_ghosts, int numVectors, int domain_boundary_condition, int my_rank, int num_ranks, level_type *parent_level){
   int box;
-  int TotalBoxes = boxes_in_i*boxes_in_i*boxes_in_i;
+  int TotalBoxes = boxes_in_i*boxes_in_j*boxes_in_k;
 
   if(my_rank==0){
   //if(domain_boundary_condition==BC_DIRICHLET)fprintf(stdout,"\nattempting to create a %d^3 level (with Dirichlet BC) using a %d^3 grid of %d^3 boxes and %d tasks...\n",box_dim*boxes_in_i,boxes_in_i,box_dim,num_ranks);
   //if(domain_boundary_condition==BC_PERIODIC )fprintf(stdout,"\nattempting to create a %d^3 level (with Periodic BC) using a %d^3 grid of %d^3 boxes and %d tasks...\n", box_dim*boxes_in_i,boxes_in_i,box_dim,num_ranks);
+    if( (boxes_in_i==boxes_in_j) && (boxes_in_i==boxes_in_k) )
                                                fprintf(stdout,"\nattempting to create a %d^3 level from %d x %d^3 boxes distributed among %d tasks...\n", box_dim*boxes_in_i,TotalBoxes,box_dim,num_ranks);
+    else                                       fprintf(stdout,"\nattempting to create a %d x %d x %d level from %d x %d^3 boxes distributed among %d tasks...\n", box_dim*boxes_in_i,box_dim*boxes_in_j,box_dim*boxes_in_k,TotalBoxes,box_dim,num_ranks);
     if(domain_boundary_condition==BC_DIRICHLET)fprintf(stdout,"  boundary condition = BC_DIRICHLET\n");
     if(domain_boundary_condition==BC_PERIODIC )fprintf(stdout,"  boundary condition = BC_PERIODIC\n");
     
@@ -1146,8 +1675,9 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
   }
   #endif
 
-  if(box_ghosts < stencil_get_radius() ){
-    if(my_rank==0)fprintf(stderr,"ghosts(%d) must be >= stencil_get_radius(%d)\n",box_ghosts,stencil_get_radius());
+  int min_ghosts = ( (parent_level!=NULL) && stencil_supports_low_order() ) ? 1 : stencil_get_radius(); // MGBuild may select the 2nd order variant for coarse levels
+  if(box_ghosts < min_ghosts ){
+    if(my_rank==0)fprintf(stderr,"ghosts(%d) must be >= %d\n",box_ghosts,min_ghosts);
     exit(0);
   }
 
@@ -1155,10 +1685,15 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
   level->box_ghosts     = box_ghosts;
   level->numVectors     = 0; // no vectors have been allocated yet
   level->vectors_base   = NULL; // pointer returned by bulk malloc
+  level->coefficients   = NULL; // allocated by pack_coefficients()
+  level->padding.kStride            = 0;
+  level->padding.vector             = 0;
+  level->padding.conflicts          = 0;
+  level->padding.unpadded_conflicts = 0;
   level->vectors        = NULL; // pointers to individual vectors
   level->boxes_in.i     = boxes_in_i;
-  level->boxes_in.j     = boxes_in_i;
-  level->boxes_in.k     = boxes_in_i;
+  level->boxes_in.j     = boxes_in_j;
+  level->boxes_in.k     = boxes_in_k;
   level->dim.i          = box_dim*level->boxes_in.i;
   level->dim.j          = box_dim*level->boxes_in.j;
   level->dim.k          = box_dim*level->boxes_in.k;
@@ -1167,13 +1702,26 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
   level->num_ranks      = num_ranks;
   level->boundary_condition.type = domain_boundary_condition;
   level->must_subtract_mean = -1;
+  level->smallest_eigenvalue_of_DinvA = 0.0;
   level->num_threads      = omp_threads;
   level->my_blocks        = NULL;
   level->num_my_blocks    = 0;
   level->allocated_blocks = 0;
   level->use_cuda         = 0;
+  level->brick            = 0;
+  level->constant_coefficients = 0;
+  level->constant_alpha   = 1.0;
+  level->constant_beta    = 1.0;
+  level->low_order        = 0;
   level->tag              = log2(level->dim.i);
   level->um_access_policy = UM_ACCESS_CPU;
+  level->smoother         = smoother_get_default();
+  level->bottom_solver    = IterativeSolver_GetDefault();
+  level->num_smooths      = 0;
+  level->chebyshev_degree = 0;
+  level->chebyshev_steps  = 1;
+  level->timers.rebuild_operator = 0;
+  reset_level_timers(level); // e.g. MGTuneTiles() times the kernels by their timers before the first MGResetTimers()
 
   // determine if this level is big enough so that it makes sense to run on GPU
   //level->use_cuda = (level->dim.i * level->dim.j * level->dim.k > HOST_LEVEL_SIZE_THRESHOLD); // this is the global problem size
@@ -1187,6 +1735,9 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
      level->rank_of_box = (int*)malloc(level->boxes_in.i*level->boxes_in.j*level->boxes_in.k*sizeof(int));
   if(level->rank_of_box==NULL){fprintf(stderr,"malloc of level->rank_of_box failed\n");exit(0);}
   for(box=0;box<level->boxes_in.i*level->boxes_in.j*level->boxes_in.k;box++){level->rank_of_box[box]=-1;}  // -1 denotes that there is no actual box assigned to this region
+     level->box_of_id = (int*)malloc(level->boxes_in.i*level->boxes_in.j*level->boxes_in.k*sizeof(int)); // inverse of my_boxes[].global_box_id (filled in by create_vectors)
+  if(level->box_of_id==NULL){fprintf(stderr,"malloc of level->box_of_id failed\n");exit(0);}
+  for(box=0;box<level->boxes_in.i*level->boxes_in.j*level->boxes_in.k;box++){level->box_of_id[box]=-1;}
 
 
   // parallelize the level (i.e. assign a process rank to each box)...
@@ -1225,6 +1776,9 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
   // determine if this level is big enough so that it makes sense to run on GPU
   level->use_cuda = (level->box_dim * level->box_dim * level->box_dim * level->num_my_boxes > HOST_LEVEL_SIZE_THRESHOLD); // this is the local problem size
   if( (parent_level != NULL) && (parent_level->use_cuda==0) ){level->use_cuda=0;} // once we switch to using the CPU, all coarser grids are on the CPU // FIX !!!
+  if(parent_level != NULL)level->constant_coefficients = parent_level->constant_coefficients; // coarse operators of a constant-coefficient operator are also constant
+  if(parent_level != NULL)level->constant_alpha        = parent_level->constant_alpha;
+  if(parent_level != NULL)level->constant_beta         = parent_level->constant_beta;
   if(my_rank==0){if(level->use_cuda)fprintf(stdout,"  This level will be run on the GPU\n");else fprintf(stdout,"  This level will be run on the host\n");fflush(stdout);}
 
 #ifdef CUDA_UM_ALLOC
@@ -1239,6 +1793,12 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
     level->um_access_policy = UM_ACCESS_CPU;		// coarse level exclusively accessed by CPU
 #endif
 
+  // merge my boxes into a single brick (one ghost zone shell and no local ghost zone exchanges) when every process's boxes form a brick...
+  #ifdef USE_BRICKS
+  level->brick = level_can_be_bricked(level);
+  if( (my_rank==0) && level->brick ){fprintf(stdout,"  Merging each process's boxes into a single brick\n");fflush(stdout);}
+  #endif
+
   // allocate my list of boxes
   level->my_boxes = (box_type*)um_malloc(level->num_my_boxes*sizeof(box_type), level->um_access_policy);
   if((level->num_my_boxes>0)&&(level->my_boxes==NULL)){fprintf(stderr,"malloc failed - create_level/level->my_boxes\n");exit(0);}
@@ -1248,41 +1808,16 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
   if(my_rank==0){fprintf(stdout,"  Allocating vectors... ");fflush(stdout);}
   create_vectors(level,numVectors);
   if(my_rank==0){fprintf(stdout,"done\n");fflush(stdout);}
+  #ifdef USE_BOX_PADDING
+  if( (my_rank==0) && !level->use_cuda ){fprintf(stdout,"  Padding vectors: jStride=%d, kStride=%d (+%d), vector offset +%d... modeled conflicts %d -> %d\n",level->box_jStride,level->box_kStride,level->padding.kStride,level->padding.vector,level->padding.unpadded_conflicts,level->padding.conflicts);fflush(stdout);}
+  #endif
 
 
   // Build and auxilarlly data structure that flattens boxes into blocks...
-  for(box=0;box<level->num_my_boxes;box++){
-    int blockcopy_i = BLOCKCOPY_TILE_I;
-    int blockcopy_j = BLOCKCOPY_TILE_J;
-    int blockcopy_k = BLOCKCOPY_TILE_K;
-
-    append_block_to_list(&(level->my_blocks),&(level->allocated_blocks),&(level->num_my_blocks),
-      /* dim.i         = */ level->my_boxes[box].dim,
-      /* dim.j         = */ level->my_boxes[box].dim,
-      /* dim.k         = */ level->my_boxes[box].dim,
-      /* read.box      = */ box,
-      /* read.ptr      = */ NULL,
-      /* read.i        = */ 0,
-      /* read.j        = */ 0,
-      /* read.k        = */ 0,
-      /* read.jStride  = */ level->my_boxes[box].jStride,
-      /* read.kStride  = */ level->my_boxes[box].kStride,
-      /* read.scale    = */ 1,
-      /* write.box     = */ box,
-      /* write.ptr     = */ NULL,
-      /* write.i       = */ 0,
-      /* write.j       = */ 0,
-      /* write.k       = */ 0,
-      /* write.jStride = */ level->my_boxes[box].jStride,
-      /* write.kStride = */ level->my_boxes[box].kStride,
-      /* write.scale   = */ 1,
-      /* blockcopy_i   = */ blockcopy_i,
-      /* blockcopy_j   = */ blockcopy_j,
-      /* blockcopy_k   = */ blockcopy_k,
-      /* subtype       = */ 0,
-      /* access policy = */ level->um_access_policy
-    );
-  }
+  build_my_blocks(level,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K);
+  int blocks_across_boxes = level->num_my_blocks;
+  thread_within_boxes(level);
+  if( (my_rank==0) && (level->num_my_blocks>blocks_across_boxes) ){fprintf(stdout,"  Threading within boxes using %d x %d x %d blocks\n",level->tile.i,level->tile.j,level->tile.k);fflush(stdout);}
 
   // build an assists data structure which specifies which cells are within the domain (used with STENCIL_FUSE_BC)
   initialize_valid_region(level);
@@ -1309,6 +1844,14 @@ void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts
   }
 
 
+  // scratch for the zline smoother's line solves (one slab of 3*box_dim^2 per thread)...
+  level->line_scratch = NULL;
+  if(level->num_my_boxes){
+    level->line_scratch = (double*)malloc(level->num_threads*3*level->box_dim*level->box_dim*sizeof(double));
+    if(level->line_scratch==NULL){fprintf(stderr,"malloc failed - create_level/level->line_scratch\n");exit(0);}
+  }
+
+
   int shape;
   // create mini program for each stencil shape to perform a ghost zone exchange...
   for(shape=0;shape<STENCIL_MAX_SHAPES;shape++)build_exchange_ghosts(    level,shape);
@@ -1385,27 +1928,30 @@ void reset_level_timers(level_type *level){
 void destroy_level(level_type *level){
 
   int i,j;
-  if(level->my_rank==0){fprintf(stdout,"attempting to free the %5d^3 level... ",level->dim.i);fflush(stdout);}
+  if(level->my_rank==0){
+    if( (level->dim.i==level->dim.j) && (level->dim.i==level->dim.k) )fprintf(stdout,"attempting to free the %5d^3 level... ",level->dim.i);
+                                                                  else fprintf(stdout,"attempting to free the %d x %d x %d level... ",level->dim.i,level->dim.j,level->dim.k);
+    fflush(stdout);
+  }
 
   // box ...
   for(i=0;i<level->num_my_boxes;i++)if(level->my_boxes[i].vectors)um_free(level->my_boxes[i].vectors, level->um_access_policy);
 
   // misc ...
   if(level->rank_of_box )free(level->rank_of_box);
+  if(level->box_of_id   )free(level->box_of_id);
   if(level->my_boxes    )um_free(level->my_boxes, level->um_access_policy);
   if(level->my_blocks   )um_free(level->my_blocks, level->um_access_policy);
   if(level->RedBlack_FP )um_free(level->RedBlack_FP, level->um_access_policy);
+  if(level->line_scratch)free(level->line_scratch);
   if(level->chebyshev_c1)um_free(level->chebyshev_c1, level->um_access_policy);
   if(level->chebyshev_c2)um_free(level->chebyshev_c2, level->um_access_policy);
 
   // FP vector data...
-  #ifdef VECTOR_MALLOC_BULK
-  if(level->vectors_base)um_free(level->vectors_base, level->um_access_policy);
+  if(level->vectors_base)um_free(level->vectors_base, level->um_access_policy); // bulk allocation (VECTOR_MALLOC_BULK or USE_BOX_PADDING)
+  else for(i=0;i<level->numVectors;i++)if(level->vectors[i])um_free(level->vectors[i], level->um_access_policy);
   if(level->vectors     )um_free(level->vectors, level->um_access_policy);
-  #else
-  for(i=0;i<level->numVectors;i++)if(level->vectors[i])um_free(level->vectors[i], level->um_access_policy);
-  if(level->vectors     )um_free(level->vectors, level->um_access_policy);
-  #endif
+  if(level->coefficients)um_free(level->coefficients, level->um_access_policy);
 
   // boundary condition mini program...
   for(i=0;i<STENCIL_MAX_SHAPES;i++){
@@ -1425,6 +1971,7 @@ void destroy_level(level_type *level){
     if(level->exchange_ghosts[i].recv_buffers)free(level->exchange_ghosts[i].recv_buffers);
     if(level->exchange_ghosts[i].recv_ranks  )free(level->exchange_ghosts[i].recv_ranks  );
     if(level->exchange_ghosts[i].recv_sizes  )free(level->exchange_ghosts[i].recv_sizes  );
+    if(level->exchange_ghosts[i].unpack_start)free(level->exchange_ghosts[i].unpack_start);
     }
     if(level->exchange_ghosts[i].num_sends>0){
 #if defined(MPI_ALLOC_PINNED)
@@ -1437,6 +1984,7 @@ void destroy_level(level_type *level){
     if(level->exchange_ghosts[i].send_buffers)free(level->exchange_ghosts[i].send_buffers);
     if(level->exchange_ghosts[i].send_ranks  )free(level->exchange_ghosts[i].send_ranks  );
     if(level->exchange_ghosts[i].send_sizes  )free(level->exchange_ghosts[i].send_sizes  );
+    if(level->exchange_ghosts[i].pack_start  )free(level->exchange_ghosts[i].pack_start  );
     }
     if(level->exchange_ghosts[i].blocks[0]   )um_free(level->exchange_ghosts[i].blocks[0], level->um_access_policy);
     if(level->exchange_ghosts[i].blocks[1]   )um_free(level->exchange_ghosts[i].blocks[1], level->um_access_policy);
@@ -1444,6 +1992,15 @@ void destroy_level(level_type *level){
     #ifdef USE_MPI
     if(level->exchange_ghosts[i].requests    )free(level->exchange_ghosts[i].requests    );
     if(level->exchange_ghosts[i].status      )free(level->exchange_ghosts[i].status      );
+    #ifdef USE_MPI_DATATYPES
+    for(j=0;j<level->exchange_ghosts[i].num_sends;j++)if(level->exchange_ghosts[i].send_types && (level->exchange_ghosts[i].send_types[j]!=MPI_DATATYPE_NULL))MPI_Type_free(&level->exchange_ghosts[i].send_types[j]);
+    for(j=0;j<level->exchange_ghosts[i].num_recvs;j++)if(level->exchange_ghosts[i].recv_types && (level->exchange_ghosts[i].recv_types[j]!=MPI_DATATYPE_NULL))MPI_Type_free(&level->exchange_ghosts[i].recv_types[j]);
+    if(level->exchange_ghosts[i].send_types  )free(level->exchange_ghosts[i].send_types  );
+    if(level->exchange_ghosts[i].recv_types  )free(level->exchange_ghosts[i].recv_types  );
+    if(level->exchange_ghosts[i].zc_requests )free(level->exchange_ghosts[i].zc_requests );
+    if(level->exchange_ghosts[i].zc_blocks[0])free(level->exchange_ghosts[i].zc_blocks[0]);
+    if(level->exchange_ghosts[i].zc_blocks[2])free(level->exchange_ghosts[i].zc_blocks[2]);
+    #endif
     #endif
   }
 
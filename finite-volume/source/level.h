@@ -19,6 +19,8 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #ifdef USE_MPI
 #include <mpi.h>
+#else
+#undef USE_MPI_DATATYPES
 #endif
 //------------------------------------------------------------------------------------------------------------------------------
 // supported boundary conditions
@@ -54,6 +56,20 @@
 #ifndef BOX_ALIGN_VOLUME
 #define BOX_ALIGN_VOLUME    8  // box volumes are a multiple of BOX_ALIGN_VOLUME ... useful for SIMD on different vectors
 #endif
+// with -DUSE_BOX_PADDING, host levels additionally pad the k-stride and the offset between vectors (in multiples of the above)
+// to minimize the streams of a stencil sweep that map to the same set of a BOX_PAD_CACHE_SETS x BOX_PAD_CACHE_WAYS cache
+#ifndef BOX_PAD_CACHE_SETS
+#define BOX_PAD_CACHE_SETS 64  // e.g. a 32KB, 8-way L1 with 64-Byte lines
+#endif
+#ifndef BOX_PAD_CACHE_WAYS
+#define BOX_PAD_CACHE_WAYS  8
+#endif
+#ifndef BOX_PAD_CACHE_LINE
+#define BOX_PAD_CACHE_LINE 64  // bytes
+#endif
+#ifndef BOX_PAD_MAX
+#define BOX_PAD_MAX        32  // maximum number of BOX_ALIGN_KSTRIDE (BOX_ALIGN_VOLUME) units added to the k-stride (vector offset)
+#endif
 //------------------------------------------------------------------------------------------------------------------------------
 typedef struct {
   int subtype;			// e.g. used to calculate normal to domain for BC's
@@ -79,13 +95,31 @@ typedef struct {
     int                 allocated_blocks[3];	//   number of blocks allocated (not necessarily used) each list...
     int                       num_blocks[3];	//   number of blocks in each list...        num_blocks[pack,local,unpack]
     blockCopy_type *              blocks[3];	//   list of block copies...                     blocks[pack,local,unpack]
+    int     * __restrict__       pack_start;	//   blocks[0][ pack_start[neighbor] .. pack_start[neighbor+1]-1 ] fill send_buffers[neighbor]
+    int     * __restrict__     unpack_start;	//   blocks[2][unpack_start[neighbor] ..unpack_start[neighbor+1]-1 ] drain recv_buffers[neighbor]
+    int                         send_coarse;	//   interpolation only... send buffers hold coarse sub-bricks (plus halo) which are interpolated by the receiver
+    int                         recv_coarse;	//   interpolation only... recv buffers hold coarse sub-bricks (plus halo) which are interpolated while unpacking
     #ifdef USE_MPI
     MPI_Request * __restrict__     requests;
     MPI_Status  * __restrict__       status;
+    #ifdef USE_MPI_DATATYPES
+    MPI_Datatype * __restrict__  send_types;	//   part of the message to each neighbor sent directly from the vector (MPI_DATATYPE_NULL if none)
+    MPI_Datatype * __restrict__  recv_types;	//   part of the message from each neighbor received directly into the ghost zones
+    MPI_Request  * __restrict__ zc_requests;	//   requests for these zero-copy messages
+    int                     num_zc_blocks[3];	//   number of blocks described by send_types/recv_types rather than packed/unpacked
+    blockCopy_type *            zc_blocks[3];	//   list of these blocks... zc_blocks[pack,unused,unpack]
+    #endif
     #endif
 } communicator_type;
 
 
+//------------------------------------------------------------------------------------------------------------------------------
+// box-relative cells outside [lo,hi) lie beyond a Dirichlet boundary of the domain (i.e. are not valid).  See initialize_valid_region()
+typedef struct {
+  struct {int i, j, k;}lo,hi;
+} valid_region_type;
+
+
 //------------------------------------------------------------------------------------------------------------------------------
 typedef struct {
   int                         global_box_id;	// used to inded into level->rank_of_box
@@ -94,7 +128,9 @@ typedef struct {
   int                                ghosts;	// ghost zone depth
   int                jStride,kStride,volume;	// useful for offsets
   int                            numVectors;	//
-  double   ** __restrict__          vectors;	// vectors[c] = pointer to 3D array for vector c for one box
+  double   ** __restrict__          vectors;	// vectors[c] = pointer to 3D array for vector c for one box (a view into the brick when the level is bricked)
+  double    * __restrict__     coefficients;	// interleaved operator coefficients of this box (-DUSE_PACKED_COEFFICIENTS)... coefficients[PACKED_COEFS*ijk+PACKED_*]
+  valid_region_type                   valid;	// cells of this box (including ghosts) which are inside the domain (replaces a VECTOR_VALID mask)
 } box_type;
 
 
@@ -106,23 +142,28 @@ typedef struct {
   int my_rank;					// my MPI rank
   int box_dim;					// dimension of each cubical box (not counting ghost zones)
   int box_ghosts;				// ghost zone depth for each box
-  int box_jStride,box_kStride,box_volume;	// useful for offsets
+  int box_jStride,box_kStride,box_volume;	// useful for offsets (when bricked, these are the strides and volume of this process's brick)
+  int brick;					// this process's boxes form one contiguous brick with a single ghost zone shell (-DUSE_BRICKS)
+  struct {int kStride, vector, conflicts, unpadded_conflicts;}padding; // padding (in doubles) chosen by the conflict model (-DUSE_BOX_PADDING) and the modeled conflicts with and without it
   int numVectors;				// number of vectors stored in each box
   int tag;					// tag each level uniquely... FIX... replace with sub commuicator
   struct {int i, j, k;}boxes_in;		// total number of boxes in i,j,k across this level
   struct {int i, j, k;}dim;			// global dimensions at this level (NOTE: dim.i == boxes_in.i * box_dim)
 
   int * rank_of_box;				// 3D array containing rank of each box.  i-major ordering
+  int * box_of_id;				// 3D array containing the index into my_boxes of each box (-1 if owned by another rank).  i-major ordering
   int    num_my_boxes;				//           number of boxes owned by this rank
   box_type * my_boxes;				// pointer to array of boxes owned by this rank
 
   // create flattened FP data... useful for CUDA/OpenMP4/OpenACC when you want to copy an entire vector to/from an accelerator
   double   ** __restrict__          vectors;	// vectors[v][box][k][j][i] = pointer to 5D array for vector v encompasing all boxes on this process... 
   double    * __restrict__     vectors_base;    // pointer used for malloc/free.  vectors[v] are shifted from this for alignment
+  double    * __restrict__     coefficients;    // interleaved operator coefficients of all boxes (-DUSE_PACKED_COEFFICIENTS, host levels)
 
   int       allocated_blocks;			//       number of blocks allocated by this rank (note, this represents a flattening of the box/cell hierarchy to facilitate threading)
   int          num_my_blocks;			//       number of blocks     owned by this rank (note, this represents a flattening of the box/cell hierarchy to facilitate threading)
   blockCopy_type * my_blocks;			// pointer to array of blocks owned by this rank (note, this represents a flattening of the box/cell hierarchy to facilitate threading)
+  struct {int i, j, k;}tile;			// tiling used to build my_blocks (BLOCKCOPY_TILE_* by default, may be changed by the autotuner)
 
   struct {
     int                type;			// BC_PERIODIC or BC_DIRICHLET
@@ -138,11 +179,22 @@ typedef struct {
   MPI_Comm MPI_COMM_ALLREDUCE;			// MPI sub communicator for just the ranks that have boxes on this level or any subsequent level... 
   #endif
   double dominant_eigenvalue_of_DinvA;		// estimate on the dominate eigenvalue of D^{-1}A
+  double smallest_eigenvalue_of_DinvA;		// estimate on the smallest eigenvalue of D^{-1}A (0.0 if unknown... see MGEstimateEigenvalues())
+  int constant_coefficients;			// alpha and beta are constant everywhere... host levels use the constant-coefficient stencil and have no ALPHA or BETA_* vectors
+  double constant_alpha, constant_beta;		// values of alpha and the beta's on a constant-coefficient level (folded into a and b by the stencil)
+  int low_order;				// host level uses the operator's 2nd order variant (see --high-order-levels)... requires only 1 ghost zone
   int must_subtract_mean;			// e.g. Poisson with Periodic BC's
   double    * __restrict__ RedBlack_FP;	        // Red/Black Mask (i.e. 0.0 or 1.0) for even/odd planes (2*kStride).  
+  double    * __restrict__ line_scratch;	// per-thread scratch (3*box_dim^2 per thread) for the zline smoother's line solves
 
   int num_threads;
 
+  int smoother;					// SMOOTHER_* used by smooth() on this level
+  int bottom_solver;				// BOTTOM_* used by IterativeSolver() when this level is the bottom of the v-cycle
+  int num_smooths;				// number of smooths performed by each call to smooth() on this level (0 = smoother's compiled default)
+  int chebyshev_degree;				// degree of the chebyshev polynomial on this level (0 = CHEBYSHEV_DEGREE).  changing it requires freeing chebyshev_c1/c2
+  int chebyshev_steps;				// chebyshev steps per ghost zone exchange (>1 = communication-avoiding).  requires box_ghosts >= chebyshev_steps*stencil_get_radius()
+
   // GPU-related info
   int use_cuda;					// run operators on this level on GPU
   int um_access_policy;				// access hints for GPU memory allocator
@@ -183,6 +235,8 @@ typedef struct {
     // Collectives...
     double   collectives;
     double         Total;
+    // Setup (not zeroed by reset_level_timers())...
+    double rebuild_operator;    // rebuild_operator_blackbox() (D^{-1}, L1^{-1}, and lambda_max)
   }timers;
   int Krylov_iterations;        // total number of bottom solver iterations
   int CAKrylov_formations_of_G; // i.e. [G,g] = [P,R]^T[P,R,rt]
@@ -191,11 +245,18 @@ typedef struct {
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-void create_level(level_type *level, int boxes_in_i, int box_dim, int box_ghosts, int numVectors, int domain_boundary_condition, int my_rank, int num_ranks, level_type *parent_level);
+void create_level(level_type *level, int boxes_in_i, int boxes_in_j, int boxes_in_k, int box_dim, int box_ghosts, int numVectors, int domain_boundary_condition, int my_rank, int num_ranks, level_type *parent_level);
 void destroy_level(level_type *level);
 void create_vectors(level_type *level, int numVectors);
+int  vector_is_allocated(level_type *level, int id);
+void release_coefficient_vectors(level_type *level);
 void reset_level_timers(level_type *level);
+void build_my_blocks(level_type *level, int tile_i, int tile_j, int tile_k);
+void thread_within_boxes(level_type *level);
 int qsortInt(const void *a, const void *b);
+void group_blocks_by_buffer(communicator_type *comm);
+void build_zero_copy(level_type *level, communicator_type *comm);
+int ghost_zone_is_shared(level_type *level, int id, int di, int dj, int dk);
 void append_block_to_list(blockCopy_type ** blocks, int *allocated_blocks, int *num_blocks,
                           int dim_i, int dim_j, int dim_k,
                           int  read_box, double*  read_ptr, int  read_i, int  read_j, int  read_k, int  read_jStride, int  read_kStride, int  read_scale,
@@ -203,6 +264,9 @@ void append_block_to_list(blockCopy_type ** blocks, int *allocated_blocks, int *
                           int my_blockcopy_tile_i, int my_blockcopy_tile_j, int my_blockcopy_tile_k,
                           int subtype, int um_access_policy
                          );
+int  blocks_in_region(int dim_i, int dim_j, int dim_k, int blockcopy_tile_i, int blockcopy_tile_j, int blockcopy_tile_k);
+void reserve_blocks_in_list(blockCopy_type ** blocks, int *allocated_blocks, int num_blocks, int um_access_policy);
+int  index_of_rank(int *ranks, int num_ranks, int rank);
 //------------------------------------------------------------------------------------------------------------------------------
 // access policies for UM
 #define UM_ACCESS_CPU  0
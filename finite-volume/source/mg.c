@@ -24,6 +24,11 @@
 #include "solvers.h"
 #include "mg.h"
 //------------------------------------------------------------------------------------------------------------------------------
+// K-cycle work vectors (MGPCG uses VECTORS_RESERVED+0..2 on every level)
+#define VECTOR_KCYCLE_C  (VECTORS_RESERVED+3)
+#define VECTOR_KCYCLE_V1 (VECTORS_RESERVED+4)
+#define VECTOR_KCYCLE_V2 (VECTORS_RESERVED+5)
+//------------------------------------------------------------------------------------------------------------------------------
 // structs/routines used to construct the restriction and prolognation lists and ensure a convention on how data is ordered within an MPI buffer
 typedef struct {
   int sendRank;
@@ -66,7 +71,10 @@ void MGPrintTiming(mg_type *all_grids, int fromLevel){
   double time,total;
           printf("\n\n");
           printf("level                     ");for(level=fromLevel;level<(num_levels  );level++){printf("%12d ",level-fromLevel);}printf("\n");
-          printf("level dimension           ");for(level=fromLevel;level<(num_levels  );level++){printf("%10d^3 ",all_grids->levels[level]->dim.i  );}printf("\n");
+          printf("level dimension           ");for(level=fromLevel;level<(num_levels  );level++){level_type *l=all_grids->levels[level];char d[32];
+                                                                                  if( (l->dim.i==l->dim.j) && (l->dim.i==l->dim.k) )snprintf(d,sizeof(d),"%d^3",l->dim.i);
+                                                                                                                                 else snprintf(d,sizeof(d),"%dx%dx%d",l->dim.i,l->dim.j,l->dim.k);
+                                                                                  printf("%12s ",d);}printf("\n");
           printf("box dimension             ");for(level=fromLevel;level<(num_levels  );level++){printf("%10d^3 ",all_grids->levels[level]->box_dim);}printf("       total\n");
   total=0;printf("------------------        ");for(level=fromLevel;level<(num_levels+1);level++){printf("------------ ");}printf("\n");
   total=0;printf("smooth                    ");for(level=fromLevel;level<(num_levels  );level++){time=scale*(double)all_grids->levels[level]->timers.smooth;               total+=time;printf("%12.6f ",time);}printf("%12.6f\n",total);
@@ -110,16 +118,493 @@ void MGPrintTiming(mg_type *all_grids, int fromLevel){
 
   printf("\n");
   printf( "   Total time in MGBuild  %12.6f seconds\n",SecondsPerCycle*(double)all_grids->timers.MGBuild);
+  printf( "      create levels       %12.6f seconds\n",SecondsPerCycle*(double)all_grids->timers.MGBuild_levels);
+  printf( "      restriction/interp. %12.6f seconds\n",SecondsPerCycle*(double)all_grids->timers.MGBuild_lists);
+  #if defined(USE_MPI) && defined(USE_SUBCOMM)
+  printf( "      subcommunicators    %12.6f seconds\n",SecondsPerCycle*(double)all_grids->timers.MGBuild_subcomm);
+  #endif
+  printf( "      rebuild operators   %12.6f seconds\n",SecondsPerCycle*(double)all_grids->timers.MGBuild_operator);
+  printf( "      tune                %12.6f seconds\n",SecondsPerCycle*(double)all_grids->timers.MGBuild_tune);
+  time=0;for(level=0;level<num_levels;level++)time+=(double)all_grids->levels[level]->timers.rebuild_operator; // includes the fine grid (rebuilt before MGBuild)
+  printf( "   Total time in D^{-1}   %12.6f seconds\n",SecondsPerCycle*time);
   printf( "   Total time in MGSolve  %12.6f seconds\n",scale*(double)all_grids->timers.MGSolve);
   printf( "      number of v-cycles  %12d\n"  ,all_grids->levels[fromLevel]->vcycles_from_this_level/all_grids->MGSolves_performed);
   printf( "Bottom solver iterations  %12d\n"  ,all_grids->levels[num_levels-1]->Krylov_iterations/all_grids->MGSolves_performed);
-  #if defined(USE_CABICGSTAB) || defined(USE_CACG)
+  if( (all_grids->levels[num_levels-1]->bottom_solver==BOTTOM_CABICGSTAB) || (all_grids->levels[num_levels-1]->bottom_solver==BOTTOM_CACG) )
   printf( "     formations of G[][]  %12d\n"  ,all_grids->levels[num_levels-1]->CAKrylov_formations_of_G/all_grids->MGSolves_performed);
-  #endif
   printf("\n\n");fflush(stdout);
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// optional (--tune-smoothers) selection of the smoother, number of smooths, and chebyshev degree on each level
+// each candidate is applied to a random error (i.e. f=0) and the reduction in ||Ae||_2 by one call to smooth() is measured along with its time
+// as the residual of a random error is dominated by high frequencies, this reduction serves as a (crude) estimate of the V-cycle convergence factor
+#ifndef SMOOTHER_TUNING_TARGET
+#define SMOOTHER_TUNING_TARGET 0.1
+#endif
+#ifndef SMOOTHER_TUNING_TRIALS
+#define SMOOTHER_TUNING_TRIALS 3
+#endif
+struct {int smoother,num_smooths,degree;} smoother_candidates[] = { // degree is only used by chebyshev
+  {SMOOTHER_GSRB    ,1,0},
+  {SMOOTHER_GSRB    ,2,0},
+  {SMOOTHER_GSRB    ,3,0},
+  {SMOOTHER_GSRB    ,4,0},
+  {SMOOTHER_CHEBY   ,1,2},
+  {SMOOTHER_CHEBY   ,1,4},
+  {SMOOTHER_CHEBY   ,1,6},
+  {SMOOTHER_CHEBY   ,1,8},
+  {SMOOTHER_L1JACOBI,2,0},
+  {SMOOTHER_L1JACOBI,4,0},
+  {SMOOTHER_L1JACOBI,6,0},
+  {SMOOTHER_L1JACOBI,8,0},
+};
+
+
+// apply candidate c to this level
+void set_smoother(level_type *level, int c){
+  int num_smooths = smoother_candidates[c].num_smooths;
+  int degree      = smoother_candidates[c].degree;
+  if( level->use_cuda && (smoother_candidates[c].smoother==SMOOTHER_CHEBY) ){
+    // the CUDA kernels are compiled for CHEBYSHEV_DEGREE.  Only the number of smooths (polynomials) may be changed on the GPU
+    num_smooths = degree/2;
+    degree      = 0;
+  }
+  if(degree!=level->chebyshev_degree){ // chebyshev coefficients must be recomputed (and reallocated) for the new degree
+    if(level->chebyshev_c1){um_free(level->chebyshev_c1,level->um_access_policy);level->chebyshev_c1=NULL;}
+    if(level->chebyshev_c2){um_free(level->chebyshev_c2,level->um_access_policy);level->chebyshev_c2=NULL;}
+  }
+  level->smoother         = smoother_candidates[c].smoother;
+  level->num_smooths      = num_smooths;
+  level->chebyshev_degree = degree;
+}
+
+
+// measure the reduction in ||Ae||_2 and the time (max across processes, min over trials) of one smooth() using the level's current smoother
+void measure_smoother(level_type *level, double a, double b, double *reduction, double *seconds){
+  int t;
+  *seconds = 1e30;
+  zero_vector(level,VECTOR_F_MINUS_AV);
+  for(t=0;t<SMOOTHER_TUNING_TRIALS;t++){
+    random_vector(level,VECTOR_U);
+    apply_op(level,VECTOR_TEMP,VECTOR_U,a,b);
+    double norm_of_Ae0 = sqrt(dot(level,VECTOR_TEMP,VECTOR_TEMP));
+    cudaDeviceSynchronize();
+    #ifdef USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+    #endif
+    double timeStart = getTime();
+    smooth(level,VECTOR_U,VECTOR_F_MINUS_AV,a,b);
+    cudaDeviceSynchronize();
+    double time = getTime()-timeStart;
+    #ifdef USE_MPI
+    double send = time;
+    MPI_Allreduce(&send,&time,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+    #endif
+    if(time<*seconds)*seconds=time;
+    apply_op(level,VECTOR_TEMP,VECTOR_U,a,b);
+    double norm_of_Ae1 = sqrt(dot(level,VECTOR_TEMP,VECTOR_TEMP));
+    *reduction = (norm_of_Ae0>0.0) ? norm_of_Ae1/norm_of_Ae0 : 0.0; // identical on all processes as dot() is a global reduction
+  }
+}
+
+
+void MGTuneSmoothers(mg_type *all_grids, double a, double b){
+  int level,c;
+  int num_levels = all_grids->num_levels;
+  int num_candidates = sizeof(smoother_candidates)/sizeof(smoother_candidates[0]);
+  double target = all_grids->options.smoother_target;
+  if(all_grids->my_rank==0){fprintf(stdout,"  Tuning smoothers for a V-cycle convergence factor of %0.3f...\n",target);fflush(stdout);}
+
+  for(level=0;level<num_levels;level++){
+    level_type *l = all_grids->levels[level];
+    if( (level==num_levels-1) && (l->bottom_solver!=BOTTOM_SMOOTH) )continue; // smooth() is not used on the bottom level
+    char saved_timers[sizeof(l->timers)];memcpy(saved_timers,&l->timers,sizeof(l->timers)); // tuning should not pollute the setup timers
+
+    int    best_fast=-1;double best_fast_time=1e30; // cheapest candidate that meets the target
+    int    best_rate=-1;double best_rate_value=0.0; // otherwise, the largest reduction per second
+    for(c=0;c<num_candidates;c++){
+      if( l->use_cuda && (smoother_candidates[c].smoother!=smoother_get_default()) )continue; // the CUDA kernels only implement the compile-time smoother
+      set_smoother(l,c);
+      double reduction,seconds;
+      measure_smoother(l,a,b,&reduction,&seconds);
+      if( (reduction<=target) && (seconds<best_fast_time) ){best_fast=c;best_fast_time=seconds;}
+      double rate = (reduction>0.0) ? -log(reduction)/seconds : 1e30;
+      if( (best_rate<0) || (rate>best_rate_value) ){best_rate=c;best_rate_value=rate;}
+    }
+
+    set_smoother(l,(best_fast>=0) ? best_fast : best_rate);
+    double reduction,seconds;
+    measure_smoother(l,a,b,&reduction,&seconds);
+
+    zero_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_F_MINUS_AV);
+    zero_vector(l,VECTOR_TEMP);
+    memcpy(&l->timers,saved_timers,sizeof(l->timers));
+    if(all_grids->my_rank==0){
+      fprintf(stdout,"    level %2d (%4d^3): %-8s x %d",level,l->dim.i,smoother_get_name(l->smoother),l->num_smooths);
+      if(l->chebyshev_degree>0)fprintf(stdout," (degree %d)",l->chebyshev_degree);
+      fprintf(stdout,"  estimated factor %0.4f, %0.6f seconds per smooth%s\n",reduction,seconds,(best_fast>=0)?"":" (target not met)");
+      fflush(stdout);
+    }
+  }
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// optional (--lanczos) estimation of the extreme eigenvalues of D^{-1}A on each level
+// the Gershgorin bound calculated by rebuild_operator() can greatly overestimate lambda_max (e.g. for 4th order) and says nothing about lambda_min
+// Jacobi-preconditioned CG (on Ae=0 from a random e) is a Lanczos iteration for D^{-1}A whose tridiagonal matrix T is formed from the CG coefficients
+// the extreme eigenvalues of T (found by bisection) are then tight estimates of those of D^{-1}A... lambda_max from below
+#ifndef LANCZOS_ITERATIONS
+#define LANCZOS_ITERATIONS 10
+#endif
+#ifndef LANCZOS_SAFETY
+#define LANCZOS_SAFETY 1.05 // Lanczos underestimates lambda_max
+#endif
+
+
+// number of eigenvalues of the symmetric tridiagonal matrix (diagonal d[], off-diagonal e[]) which are less than x (Sturm sequence)
+int tridiagonal_eigenvalues_below(int n, double *d, double *e, double x){
+  int i,count=0;
+  double q=1.0;
+  for(i=0;i<n;i++){
+    q = d[i] - x - ( (i>0) ? e[i-1]*e[i-1]/q : 0.0 );
+    if(q==0.0)q=-1e-300;
+    if(q<0.0)count++;
+  }
+  return(count);
+}
+
+
+// bisection for the m'th smallest (0-based) eigenvalue of the symmetric tridiagonal matrix (d,e)
+double tridiagonal_eigenvalue(int n, double *d, double *e, int m){
+  int i,t;
+  double lo=d[0],hi=d[0];
+  for(i=0;i<n;i++){ // Gershgorin bounds on the spectrum of T
+    double r = ( (i>0) ? fabs(e[i-1]) : 0.0 ) + ( (i<n-1) ? fabs(e[i]) : 0.0 );
+    if(d[i]-r<lo)lo=d[i]-r;
+    if(d[i]+r>hi)hi=d[i]+r;
+  }
+  for(t=0;t<100;t++){
+    double mid = 0.5*(lo+hi);
+    if( (mid<=lo) || (mid>=hi) )break;
+    if(tridiagonal_eigenvalues_below(n,d,e,mid)>m)hi=mid;
+                                             else lo=mid;
+  }
+  return(0.5*(lo+hi));
+}
+
+
+// estimate the smallest and largest eigenvalues of D^{-1}A on this level with (at most) iterations Lanczos steps.  returns 0 if CG broke down immediately
+// VECTOR_F_MINUS_AV (r), VECTOR_U (p), and VECTOR_TEMP (Ap, D^{-1}r) are used as scratch
+int lanczos_eigenvalues(level_type *level, double a, double b, int iterations, double *lambda_min, double *lambda_max){
+  int r_id = VECTOR_F_MINUS_AV;
+  int p_id = VECTOR_U;
+  int w_id = VECTOR_TEMP;
+  double d[iterations],e[iterations];
+  double alpha_prev=0.0,beta_prev=0.0;
+  int n=0;
+
+  random_vector(level,r_id);
+  if(level->must_subtract_mean==1)shift_vector(level,r_id,r_id,-mean(level,r_id)); // remove the null space of A
+  mul_vectors(level,w_id,1.0,VECTOR_DINV,r_id);                 // z = D^{-1}r
+  double r_dot_z = dot(level,r_id,w_id);
+  add_vectors(level,p_id,1.0,w_id,0.0,w_id);                    // p = z
+  while( (n<iterations) && (r_dot_z>0.0) ){
+    apply_op(level,w_id,p_id,a,b);                              // Ap
+    double p_dot_Ap = dot(level,p_id,w_id);
+    if(p_dot_Ap<=0.0)break;
+    double alpha = r_dot_z/p_dot_Ap;
+    d[n] = 1.0/alpha + ( (n>0) ? beta_prev/alpha_prev : 0.0 );  // T[n][n]
+    add_vectors(level,r_id,1.0,r_id,-alpha,w_id);               // r = r - alpha*Ap
+    mul_vectors(level,w_id,1.0,VECTOR_DINV,r_id);               // z = D^{-1}r
+    double r_dot_z_new = dot(level,r_id,w_id);
+    double beta = r_dot_z_new/r_dot_z;
+    e[n] = sqrt(fabs(beta))/alpha;                              // T[n][n+1]
+    add_vectors(level,p_id,1.0,w_id,beta,p_id);                 // p = z + beta*p
+    r_dot_z = r_dot_z_new;
+    alpha_prev = alpha;
+    beta_prev  = beta;
+    n++;
+  }
+  if(n==0)return(0);
+  *lambda_min = tridiagonal_eigenvalue(n,d,e,0  );
+  *lambda_max = tridiagonal_eigenvalue(n,d,e,n-1);
+  return(1);
+}
+
+
+void MGEstimateEigenvalues(mg_type *all_grids, double a, double b){
+  int level;
+  if(all_grids->my_rank==0){fprintf(stdout,"  Estimating the eigenvalues of D^{-1}A with %d Lanczos iterations...\n",all_grids->options.lanczos_iterations);fflush(stdout);}
+  for(level=0;level<all_grids->num_levels;level++){
+    level_type *l = all_grids->levels[level];
+    int iterations = all_grids->options.lanczos_iterations;
+    double cells = (double)l->dim.i*(double)l->dim.j*(double)l->dim.k;
+    if(iterations>cells)iterations=(int)cells; // T can have no more eigenvalues than D^{-1}A
+    double lambda_min,lambda_max;
+    if(!lanczos_eigenvalues(l,a,b,iterations,&lambda_min,&lambda_max))continue; // keep the Gershgorin bound
+    lambda_max *= LANCZOS_SAFETY;
+    if(lambda_max>l->dominant_eigenvalue_of_DinvA)lambda_max=l->dominant_eigenvalue_of_DinvA; // the Gershgorin bound is never exceeded
+    if(all_grids->my_rank==0){fprintf(stdout,"    level %2d (%4d^3): lambda_min %1.6e  lambda_max %1.6e  (Gershgorin %1.6e)\n",level,l->dim.i,lambda_min,lambda_max,l->dominant_eigenvalue_of_DinvA);fflush(stdout);}
+    l->dominant_eigenvalue_of_DinvA = lambda_max;
+    l->smallest_eigenvalue_of_DinvA = (lambda_min>0.0) ? lambda_min : 0.0;
+    if(l->chebyshev_c1){um_free(l->chebyshev_c1,l->um_access_policy);l->chebyshev_c1=NULL;} // GPU levels compute their coefficients once
+    if(l->chebyshev_c2){um_free(l->chebyshev_c2,l->um_access_policy);l->chebyshev_c2=NULL;}
+    zero_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_F_MINUS_AV);
+    zero_vector(l,VECTOR_TEMP);
+  }
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// the communication-avoiding Chebyshev smoother (--chebyshev-ca) must reproduce the exchange-every-step smoother to round-off
+// smooth the same random vector both ways (D^{-1}, whose ghost zones are already exchanged, serves as the right-hand side) and compare
+// this self-check is only compiled (and run during MGBuild) with -DCHEBYSHEV_CA_CHECK
+#ifdef CHEBYSHEV_CA_CHECK
+#ifndef CHEBYSHEV_CA_TOLERANCE
+#define CHEBYSHEV_CA_TOLERANCE 1e-12
+#endif
+void MGCheckChebyshevSteps(mg_type *all_grids, double a, double b){
+  int level;
+  if(all_grids->my_rank==0){fprintf(stdout,"  Checking the communication-avoiding Chebyshev smoother...\n");fflush(stdout);}
+  for(level=0;level<all_grids->num_levels;level++){
+    level_type *l = all_grids->levels[level];
+    if( l->use_cuda || l->brick || (l->chebyshev_steps<2) )continue; // smooth_chebyshev() exchanges every step
+    char saved_timers[sizeof(l->timers)];memcpy(saved_timers,&l->timers,sizeof(l->timers)); // checking should not pollute the setup timers
+    int smoother = l->smoother;
+    int steps    = l->chebyshev_steps;
+    l->smoother  = SMOOTHER_CHEBY;
+
+    l->chebyshev_steps = 1;
+    random_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_TEMP);
+    smooth(l,VECTOR_U,VECTOR_DINV,a,b);
+    add_vectors(l,VECTOR_F_MINUS_AV,1.0,VECTOR_U,0.0,VECTOR_U);
+
+    l->chebyshev_steps = steps;
+    random_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_TEMP);
+    smooth(l,VECTOR_U,VECTOR_DINV,a,b);
+    double difference = error(l,VECTOR_U,VECTOR_F_MINUS_AV)/norm(l,VECTOR_F_MINUS_AV);
+
+    l->smoother = smoother;
+    zero_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_F_MINUS_AV);
+    zero_vector(l,VECTOR_TEMP);
+    memcpy(&l->timers,saved_timers,sizeof(l->timers));
+    if(all_grids->my_rank==0){fprintf(stdout,"    level %2d (%4d^3): %d steps per exchange, relative difference %e\n",level,l->dim.i,steps,difference);fflush(stdout);}
+    if(difference>CHEBYSHEV_CA_TOLERANCE){
+      if(all_grids->my_rank==0){fprintf(stderr,"error... the communication-avoiding Chebyshev smoother does not reproduce the exchange-every-step smoother on level %d\n",level);}
+      #ifdef USE_MPI
+      MPI_Finalize();
+      #endif
+      exit(0);
+    }
+  }
+}
+#endif
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// defaults are those selected at compile time (i.e. -DUSE_FCYCLES, -DUSE_BICGSTAB, -DUSE_GSRB, ...)
+void MGDefaultOptions(mg_options_type *options){
+  #if   defined(USE_FCYCLES)
+  options->cycle = MG_CYCLE_F;
+  #elif defined(USE_UCYCLES)
+  options->cycle = MG_CYCLE_U;
+  #else
+  options->cycle = MG_CYCLE_V;
+  #endif
+  options->bottom_solver = IterativeSolver_GetDefault();
+  options->num_smoothers = 1;
+  options->smoothers[0]  = smoother_get_default();
+  options->smoother_target = 0.0;
+  options->max_coarse_dim  = MAX_COARSE_DIM;
+  options->constant_coefficients = 0;
+  options->lanczos_iterations = 0;
+  options->num_chebyshev_steps = 0;
+  options->num_cycle_indices = 0;
+  options->kcycle = 0;
+  options->high_order_levels = 0;
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// parse (and remove from argv) the runtime MG options...
+//   --cycle=[v|f|u]
+//   --bottom-solver=[smooth|bicgstab|cg|cabicgstab|cacg]
+//   --smoother=name[,name,...]    one smoother per level starting with the finest.  The last one is used on all coarser levels (zline is experimental)
+//   --tune-smoothers[=factor]     measure the candidate smoothers on each level and select the cheapest one that meets the target convergence factor
+//   --constant-coefficients[=auto] if alpha and the beta's are constant, fold them into a and b and store no coefficient vectors (auto = no warning if they are not)
+//   --lanczos[=iterations]        estimate the extreme eigenvalues of D^{-1}A on each level (used to fit the chebyshev smoother)
+//   --chebyshev-ca=s[,s,...]      chebyshev steps per (deep) ghost zone exchange starting with the finest level.  The last one is used on all coarser levels
+//   --cycle-index=g[,g,...]       coarse grid corrections (1=V, 2=W) per visit of each level starting with the finest.  The last one is used on all coarser levels
+//   --kcycle                      accelerate the coarse grid corrections of levels with a cycle index of 2 with flexible CG (implies --cycle-index=2 if not given)
+//   --high-order-levels=N         only the N finest levels (counted from the level a solve starts on) use the high-order operator.  Coarser (host) levels use its 2nd order variant (defect correction)
+// returns 0 if an option was not recognized
+int MGParseOptions(mg_options_type *options, int *argc, char **argv){
+  int a,n=1;
+  int success=1;
+  for(a=1;a<*argc;a++){
+    char *arg = argv[a];
+    if(strncmp(arg,"--cycle=",8)==0){
+      char *value = arg+8;
+           if(strcmp(value,"v")==0 || strcmp(value,"V")==0)options->cycle = MG_CYCLE_V;
+      else if(strcmp(value,"f")==0 || strcmp(value,"F")==0)options->cycle = MG_CYCLE_F;
+      else if(strcmp(value,"u")==0 || strcmp(value,"U")==0)options->cycle = MG_CYCLE_U;
+      else{fprintf(stderr,"unrecognized cycle type '%s'\n",value);success=0;}
+    }else
+    if(strncmp(arg,"--bottom-solver=",16)==0){
+      int bottom_solver = IterativeSolver_GetID(arg+16);
+      if(bottom_solver<0){fprintf(stderr,"unrecognized bottom solver '%s'\n",arg+16);success=0;}
+                    else{options->bottom_solver = bottom_solver;}
+    }else
+    if(strncmp(arg,"--smoother=",11)==0){
+      char list[1024];
+      strncpy(list,arg+11,sizeof(list)-1);list[sizeof(list)-1]='\0';
+      options->num_smoothers=0;
+      char *name = strtok(list,",");
+      while( (name!=NULL) && (options->num_smoothers<MG_MAX_LEVELS) ){
+        int smoother = smoother_get_id(name);
+        if(smoother<0){fprintf(stderr,"unrecognized smoother '%s'\n",name);success=0;break;}
+        options->smoothers[options->num_smoothers++] = smoother;
+        name = strtok(NULL,",");
+      }
+      if(options->num_smoothers==0){options->num_smoothers=1;options->smoothers[0]=smoother_get_default();}
+    }else
+    if(strcmp(arg,"--tune-smoothers")==0){
+      options->smoother_target = SMOOTHER_TUNING_TARGET;
+    }else
+    if(strncmp(arg,"--tune-smoothers=",17)==0){
+      options->smoother_target = atof(arg+17);
+      if( (options->smoother_target<=0.0) || (options->smoother_target>=1.0) ){fprintf(stderr,"convergence factor for --tune-smoothers must be in (0,1)\n");success=0;}
+    }else
+    if(strncmp(arg,"--max-coarse-dim=",17)==0){
+      options->max_coarse_dim = atoi(arg+17);
+      if(options->max_coarse_dim<1){fprintf(stderr,"--max-coarse-dim must be at least 1\n");success=0;}
+    }else
+    if(strcmp(arg,"--constant-coefficients")==0){
+      options->constant_coefficients = 1;
+    }else
+    if(strcmp(arg,"--constant-coefficients=auto")==0){
+      options->constant_coefficients = -1;
+    }else
+    if(strcmp(arg,"--lanczos")==0){
+      options->lanczos_iterations = LANCZOS_ITERATIONS;
+    }else
+    if(strncmp(arg,"--chebyshev-ca=",15)==0){
+      char list[1024];
+      strncpy(list,arg+15,sizeof(list)-1);list[sizeof(list)-1]='\0';
+      options->num_chebyshev_steps=0;
+      char *steps = strtok(list,",");
+      while( (steps!=NULL) && (options->num_chebyshev_steps<MG_MAX_LEVELS) ){
+        if(atoi(steps)<1){fprintf(stderr,"--chebyshev-ca requires at least 1 step per exchange\n");success=0;break;}
+        options->chebyshev_steps[options->num_chebyshev_steps++] = atoi(steps);
+        steps = strtok(NULL,",");
+      }
+    }else
+    if(strncmp(arg,"--cycle-index=",14)==0){
+      char list[1024];
+      strncpy(list,arg+14,sizeof(list)-1);list[sizeof(list)-1]='\0';
+      options->num_cycle_indices=0;
+      char *index = strtok(list,",");
+      while( (index!=NULL) && (options->num_cycle_indices<MG_MAX_LEVELS) ){
+        if( (atoi(index)<1) || (atoi(index)>2) ){fprintf(stderr,"--cycle-index must be 1 (V) or 2 (W)\n");success=0;break;}
+        options->cycle_index[options->num_cycle_indices++] = atoi(index);
+        index = strtok(NULL,",");
+      }
+    }else
+    if(strcmp(arg,"--kcycle")==0){
+      options->kcycle = 1;
+    }else
+    if(strncmp(arg,"--high-order-levels=",20)==0){
+      options->high_order_levels = atoi(arg+20);
+      if(options->high_order_levels<1){fprintf(stderr,"--high-order-levels requires at least 1 level\n");success=0;}
+    }else
+    if(strncmp(arg,"--lanczos=",10)==0){
+      options->lanczos_iterations = atoi(arg+10);
+      if(options->lanczos_iterations<1){fprintf(stderr,"--lanczos requires at least 1 iteration\n");success=0;}
+    }else
+    if(strncmp(arg,"--",2)==0){
+      fprintf(stderr,"unrecognized option '%s'\n",arg);success=0;
+    }else{
+      argv[n++]=arg; // keep positional arguments
+    }
+  }
+  *argc=n;
+  if(options->kcycle && (options->num_cycle_indices==0)){options->num_cycle_indices=1;options->cycle_index[0]=2;} // K-cycles on every level
+  return(success);
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+void MGPrintOptions(mg_options_type *options){
+  int s;
+  const char *cycle_names[3] = {"V","F","U"};
+  fprintf(stdout,"  cycle type    = %s-cycle\n",cycle_names[options->cycle]);
+  fprintf(stdout,"  bottom solver = %s\n",IterativeSolver_GetName(options->bottom_solver));
+  fprintf(stdout,"  smoother(s)   =");
+  for(s=0;s<options->num_smoothers;s++)fprintf(stdout," %s",smoother_get_name(options->smoothers[s]));
+  if(options->num_smoothers>1)fprintf(stdout," (finest to coarsest)");
+  if(options->smoother_target>0.0)fprintf(stdout," (tuned for a convergence factor of %0.3f)",options->smoother_target);
+  fprintf(stdout,"\n");
+  if(options->constant_coefficients)fprintf(stdout,"  coefficients  = constant%s\n",(options->constant_coefficients<0)?" (if detected)":"");
+  if(options->lanczos_iterations>0)fprintf(stdout,"  eigenvalues   = %d Lanczos iterations per level\n",options->lanczos_iterations);
+  if(options->num_chebyshev_steps>0){
+    fprintf(stdout,"  chebyshev     = communication-avoiding with");
+    for(s=0;s<options->num_chebyshev_steps;s++)fprintf(stdout," %d",options->chebyshev_steps[s]);
+    fprintf(stdout," step(s) per exchange%s\n",(options->num_chebyshev_steps>1)?" (finest to coarsest)":"");
+  }
+  if(options->num_cycle_indices>0){
+    fprintf(stdout,"  cycle index   =");
+    for(s=0;s<options->num_cycle_indices;s++)fprintf(stdout," %d",options->cycle_index[s]);
+    if(options->num_cycle_indices>1)fprintf(stdout," (finest to coarsest)");
+    if(options->kcycle)fprintf(stdout," (flexible CG accelerated K-cycle)");
+    fprintf(stdout,"\n");
+  }
+  if(options->high_order_levels>0)fprintf(stdout,"  operator      = high-order on the %d finest level(s), 2nd order (defect correction) below\n",options->high_order_levels);
+  fflush(stdout);
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// chebyshev steps per ghost zone exchange requested (--chebyshev-ca) for this level.  The level's ghost zones must be stencil_get_radius() times deeper
+int MGChebyshevSteps(mg_options_type *options, int level){
+  if(options->num_chebyshev_steps<1)return(1);
+  return( options->chebyshev_steps[ (level<options->num_chebyshev_steps) ? level : options->num_chebyshev_steps-1 ] );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// number of coarse grid corrections (--cycle-index) computed for each visit of this level
+int MGCycleIndex(mg_options_type *options, int level){
+  if(options->num_cycle_indices<1)return(1);
+  return( options->cycle_index[ (level<options->num_cycle_indices) ? level : options->num_cycle_indices-1 ] );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// returns 1 if alpha (unless a==0) is constant and the beta's are one (nonzero) constant on this level along with those constants
+// a candidate constant is the max norm of the vector (i.e. the value of one of its elements) with the sign of its mean
+int MGDetectConstantCoefficients(level_type *level, double a, double *alpha, double *beta){
+  int c,constant=1;
+  *alpha = 1.0;
+  *beta  = (mean(level,VECTOR_BETA_I)<0.0) ? -norm(level,VECTOR_BETA_I) : norm(level,VECTOR_BETA_I);
+  if(a!=0.0)*alpha = (mean(level,VECTOR_ALPHA)<0.0) ? -norm(level,VECTOR_ALPHA) : norm(level,VECTOR_ALPHA);
+  for(c=VECTOR_ALPHA;c<=VECTOR_BETA_K;c++){
+    if( (c==VECTOR_ALPHA) && (a==0.0) )continue; // alpha is irrelevant for Poisson
+    shift_vector(level,VECTOR_TEMP,c,(c==VECTOR_ALPHA) ? -*alpha : -*beta);
+    if(norm(level,VECTOR_TEMP)!=0.0)constant=0;
+  }
+  if(*beta==0.0)constant=0;
+  return(constant);
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------------------------------------
 // zeros all timers within this MG hierarchy
 void MGResetTimers(mg_type *all_grids){
@@ -131,12 +616,155 @@ void MGResetTimers(mg_type *all_grids){
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------------------------------------
+// Autotune the tiling used to build my_blocks on each level.
+//  - smooth() and residual() are timed on the real level data for a small set of candidate tilings and my_blocks is rebuilt with the fastest
+//  - the winners are appended to TILE_TUNING_FILE keyed by (hostname,ranks,threads,level dims,box dim,smoother) so subsequent runs start tuned
+//  - GPU levels are skipped as the CUDA kernels are templated on the compile-time BLOCKCOPY_TILE_*
+#ifdef USE_TILE_AUTOTUNE
+#ifndef TILE_TUNING_FILE
+#define TILE_TUNING_FILE   "hpgmg-fv.tiles"
+#endif
+#ifndef TILE_TUNING_TRIALS
+#define TILE_TUNING_TRIALS 3
+#endif
+static int tile_candidates[][3] = { // candidates are clipped to the box dimension and duplicates are skipped
+  {BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K}, // compile-time default
+  {10000,10000,10000}, // one block per box
+  {10000,   16,   16},
+  {10000,    8,    8},
+  {10000,    4,    8},
+  {10000,    4,    4},
+  {10000,    2,    8},
+  {10000,    1,    8},
+  {   64,    8,    8},
+  {   32,    4,    8},
+  {   16,    8,    8},
+};
+
+
+// time one smooth and one residual (kernels only, i.e. not the ghost zone exchange) using the current my_blocks
+// x=VECTOR_U and rhs=VECTOR_F_MINUS_AV (zeroed by the caller) as the kernels' x and rhs are distinct __restrict__ pointers
+// returns the minimum over trials of the maximum across processes
+double time_smooth_and_residual(level_type *level, double a, double b, int trials){
+  int t;
+  double best = 1e30;
+  smooth(level,VECTOR_U,VECTOR_F_MINUS_AV,a,b); // warmup
+  for(t=0;t<trials;t++){
+    double timeStart = level->timers.smooth + level->timers.residual;
+    smooth(level,VECTOR_U,VECTOR_F_MINUS_AV,a,b);
+    residual(level,VECTOR_TEMP,VECTOR_U,VECTOR_F_MINUS_AV,a,b);
+    double time = level->timers.smooth + level->timers.residual - timeStart;
+    #ifdef USE_MPI
+    double send = time;
+    MPI_Allreduce(&send,&time,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+    #endif
+    if(time<best)best=time;
+  }
+  return(best);
+}
+
+
+void MGTuneTiles(mg_type *all_grids, double a, double b){
+  int level,c,n;
+  int num_levels = all_grids->num_levels;
+  int num_ranks  = all_grids->levels[0]->num_ranks;
+  int num_threads= all_grids->levels[0]->num_threads;
+  int num_candidates = sizeof(tile_candidates)/sizeof(tile_candidates[0]);
+  char hostname[256];
+  gethostname(hostname,sizeof(hostname));hostname[255]='\0';
+  for(n=0;hostname[n];n++)if(hostname[n]==' ')hostname[n]='_';
+
+  // process 0 looks for previously tuned tilings in the tuning file...
+  int *tuned = (int*)malloc(4*num_levels*sizeof(int)); // found,i,j,k for each level
+  if(tuned==NULL){fprintf(stderr,"malloc failed - MGTuneTiles/tuned\n");exit(0);}
+  for(n=0;n<4*num_levels;n++)tuned[n]=0;
+  if(all_grids->my_rank==0){
+    FILE *fp = fopen(TILE_TUNING_FILE,"r");
+    if(fp){
+      char line[1024],host[256];
+      int ranks,threads,dim_i,dim_j,dim_k,box_dim,smoother,ti,tj,tk;
+      while(fgets(line,sizeof(line),fp)){
+        if(sscanf(line,"%255s %d %d %d %d %d %d %d %d %d %d",host,&ranks,&threads,&dim_i,&dim_j,&dim_k,&box_dim,&smoother,&ti,&tj,&tk)!=11)continue; // e.g. entries in an older format
+        for(level=0;level<num_levels;level++){ // later entries override earlier ones
+          if( (strcmp(host,hostname)==0) && (ranks==num_ranks) && (threads==num_threads) &&
+              (dim_i==all_grids->levels[level]->dim.i) && (dim_j==all_grids->levels[level]->dim.j) && (dim_k==all_grids->levels[level]->dim.k) &&
+              (box_dim==all_grids->levels[level]->box_dim) && (smoother==all_grids->levels[level]->smoother) &&
+              (ti>0) && (tj>0) && (tk>0) ){
+            tuned[4*level+0]=1;tuned[4*level+1]=ti;tuned[4*level+2]=tj;tuned[4*level+3]=tk;
+          }
+        }
+      }
+      fclose(fp);
+    }
+  }
+  #ifdef USE_MPI
+  MPI_Bcast(tuned,4*num_levels,MPI_INT,0,MPI_COMM_WORLD);
+  #endif
+
+  if(all_grids->my_rank==0){fprintf(stdout,"  Tuning tile sizes...\n");fflush(stdout);}
+  FILE *fp = NULL;
+  for(level=0;level<num_levels;level++){
+    level_type *l = all_grids->levels[level];
+    if(l->use_cuda)continue;
+    int box_dim = l->box_dim;
+
+    if(tuned[4*level+0]){
+      build_my_blocks(l,tuned[4*level+1],tuned[4*level+2],tuned[4*level+3]);
+      if(all_grids->my_rank==0){fprintf(stdout,"    level %2d (%4d x %4d x %4d, %3d^3 boxes): tile %5d x %5d x %5d (from %s)\n",level,l->dim.i,l->dim.j,l->dim.k,box_dim,l->tile.i,l->tile.j,l->tile.k,TILE_TUNING_FILE);fflush(stdout);}
+      continue;
+    }
+
+    // try each candidate (clipped to the box dimension) on the real kernels...
+    char saved_timers[sizeof(l->timers)];memcpy(saved_timers,&l->timers,sizeof(l->timers)); // tuning should not pollute the setup timers
+    zero_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_F_MINUS_AV);
+    double best_time = 1e30;
+    int best_i=0,best_j=0,best_k=0;
+    for(c=0;c<num_candidates;c++){
+      int ti = (tile_candidates[c][0]<box_dim) ? tile_candidates[c][0] : box_dim;
+      int tj = (tile_candidates[c][1]<box_dim) ? tile_candidates[c][1] : box_dim;
+      int tk = (tile_candidates[c][2]<box_dim) ? tile_candidates[c][2] : box_dim;
+      int duplicate=0;
+      for(n=0;n<c;n++){
+        if( (ti==((tile_candidates[n][0]<box_dim)?tile_candidates[n][0]:box_dim)) &&
+            (tj==((tile_candidates[n][1]<box_dim)?tile_candidates[n][1]:box_dim)) &&
+            (tk==((tile_candidates[n][2]<box_dim)?tile_candidates[n][2]:box_dim)) )duplicate=1;
+      }
+      if(duplicate)continue;
+      build_my_blocks(l,ti,tj,tk);
+      double time = time_smooth_and_residual(l,a,b,TILE_TUNING_TRIALS);
+      if(time<best_time){best_time=time;best_i=ti;best_j=tj;best_k=tk;}
+    }
+    build_my_blocks(l,best_i,best_j,best_k);
+    zero_vector(l,VECTOR_U);
+    zero_vector(l,VECTOR_F_MINUS_AV);
+    zero_vector(l,VECTOR_TEMP);
+    memcpy(&l->timers,saved_timers,sizeof(l->timers));
+    if(all_grids->my_rank==0){
+      fprintf(stdout,"    level %2d (%4d x %4d x %4d, %3d^3 boxes): tile %5d x %5d x %5d (%0.6f seconds per smooth+residual)\n",level,l->dim.i,l->dim.j,l->dim.k,box_dim,best_i,best_j,best_k,best_time);fflush(stdout);
+      if(fp==NULL)fp = fopen(TILE_TUNING_FILE,"a");
+      if(fp)fprintf(fp,"%s %d %d %d %d %d %d %d %d %d %d\n",hostname,num_ranks,num_threads,l->dim.i,l->dim.j,l->dim.k,box_dim,l->smoother,best_i,best_j,best_k);
+    }
+  }
+  if(fp)fclose(fp);
+  free(tuned);
+}
+#endif
+
+
 //----------------------------------------------------------------------------------------------------------------------------------------------------
 // build a list of operations and MPI buffers to affect distributed interpolation
 // the three lists constitute
 //   - buffer packing (i.e. interpolate a local box (or region of a box) and place the result in an MPI buffer)
 //   - local operations (i.e. interpolate a local box (or region of a box) and place the result in another local box)
 //   - buffer upacking (i.e. take interpolated data recieved from another process and use it to increment a local box)
+// With -DUSE_RECEIVER_INTERPOLATION, host level pairs may instead pack the coarse data (plus halo) and interpolate while unpacking.
+// The halo is the number of coarse cells beyond a sub-brick that interpolation reads (v4 reads 2, p1/p2/v2 read 1)
+static int interpolation_halo(level_type *level_c){
+  return( (level_c->box_ghosts<2) ? level_c->box_ghosts : 2 );
+}
+
 void build_interpolation(mg_type *all_grids){
   int level;
   for(level=0;level<all_grids->num_levels;level++){
@@ -159,11 +787,28 @@ void build_interpolation(mg_type *all_grids){
   all_grids->levels[level]->interpolation.allocated_blocks[0] = 0;
   all_grids->levels[level]->interpolation.allocated_blocks[1] = 0;
   all_grids->levels[level]->interpolation.allocated_blocks[2] = 0;
+  all_grids->levels[level]->interpolation.send_coarse         = 0;
+  all_grids->levels[level]->interpolation.recv_coarse         = 0;
   #ifdef USE_MPI
   all_grids->levels[level]->interpolation.requests            = NULL;
   all_grids->levels[level]->interpolation.status              = NULL;
   #endif
 
+  // receiver-side interpolation (-DUSE_RECEIVER_INTERPOLATION)... remote fine boxes are sent the coarse sub-brick (plus halo)
+  // from which they are interpolated (nearly 1/8th the data for large boxes) rather than the interpolated result.  The GPU path interpolates on the device.
+  // Thus, only host level pairs qualify and every rank must make the same decision.
+  #if defined(USE_RECEIVER_INTERPOLATION) && defined(USE_MPI)
+  if(level<all_grids->num_levels-1){
+    int use_cuda = all_grids->levels[level]->use_cuda || all_grids->levels[level+1]->use_cuda;
+    int any_cuda = use_cuda;
+    MPI_Allreduce(&use_cuda,&any_cuda,1,MPI_INT,MPI_MAX,MPI_COMM_WORLD);
+    int fineDim = all_grids->levels[level]->box_dim;
+    int haloDim = fineDim/2 + 2*interpolation_halo(all_grids->levels[level+1]);
+    all_grids->levels[level]->interpolation.recv_coarse = !any_cuda && (haloDim*haloDim*haloDim < fineDim*fineDim*fineDim); // the halo dominates small boxes
+  }
+  if(level>0)all_grids->levels[level]->interpolation.send_coarse = all_grids->levels[level-1]->interpolation.recv_coarse; // same level pair
+  #endif
+
 
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // construct pack, send(to level-1), and local...
@@ -192,7 +837,7 @@ void build_interpolation(mg_type *all_grids){
         int fineBox_j = (all_grids->levels[level-1]->boxes_in.j/all_grids->levels[level]->boxes_in.j)*coarseBox_j + bj;
         int fineBox_k = (all_grids->levels[level-1]->boxes_in.k/all_grids->levels[level]->boxes_in.k)*coarseBox_k + bk;
         int fineBoxID =  fineBox_i + fineBox_j*all_grids->levels[level-1]->boxes_in.i + fineBox_k*all_grids->levels[level-1]->boxes_in.i*all_grids->levels[level-1]->boxes_in.j;
-        int fineBox   = -1;int f;for(f=0;f<all_grids->levels[level-1]->num_my_boxes;f++)if( all_grids->levels[level-1]->my_boxes[f].global_box_id == fineBoxID )fineBox=f; // try and find the index of a fineBox global_box_id == fineBoxID
+        int fineBox   = all_grids->levels[level-1]->box_of_id[fineBoxID]; // -1 if off-node
         fineBoxes[numFineBoxes].sendRank  = all_grids->levels[level  ]->rank_of_box[coarseBoxID];
         fineBoxes[numFineBoxes].sendBoxID = coarseBoxID;
         fineBoxes[numFineBoxes].sendBox   = coarseBox;
@@ -228,8 +873,19 @@ void build_interpolation(mg_type *all_grids){
     }
 
     int elementSize = all_grids->levels[level-1]->box_dim*all_grids->levels[level-1]->box_dim*all_grids->levels[level-1]->box_dim;
+    int halo        = 0;
+    int haloDim     = all_grids->levels[level-1]->box_dim/2;
+    if(all_grids->levels[level]->interpolation.send_coarse){
+      halo        = interpolation_halo(all_grids->levels[level]);
+      haloDim     = all_grids->levels[level-1]->box_dim/2 + 2*halo;
+      elementSize = haloDim*haloDim*haloDim;
+    }
     //printf("level=%d, rank=%2d, send_buffers=%6d\n",level,all_grids->my_rank,numFineBoxesRemote*elementSize*sizeof(double));
 
+    // size the pack and local lists exactly...
+    reserve_blocks_in_list(&(all_grids->levels[level]->interpolation.blocks[0]),&(all_grids->levels[level]->interpolation.allocated_blocks[0]),numFineBoxesRemote*blocks_in_region(haloDim,haloDim,haloDim,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K),all_grids->levels[level]->um_access_policy);
+    reserve_blocks_in_list(&(all_grids->levels[level]->interpolation.blocks[1]),&(all_grids->levels[level]->interpolation.allocated_blocks[1]),numFineBoxesLocal *blocks_in_region(all_grids->levels[level-1]->box_dim/2,all_grids->levels[level-1]->box_dim/2,all_grids->levels[level-1]->box_dim/2,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K),all_grids->levels[level]->um_access_policy);
+
     // for each neighbor, construct the pack list and allocate the MPI send buffer... 
     for(neighbor=0;neighbor<numFineRanks;neighbor++){
       int fineBox;
@@ -239,7 +895,36 @@ void build_interpolation(mg_type *all_grids){
              all_grids->levels[level]->interpolation.send_buffers[neighbor] = (double*)um_malloc(malloc_size*sizeof(double),UM_ACCESS_BOTH);
           if(all_grids->levels[level]->interpolation.send_buffers[neighbor]==NULL){fprintf(stderr,"malloc failed - interpolation/all_send_buffers\n");exit(0);}
       memset(all_grids->levels[level]->interpolation.send_buffers[neighbor],0,malloc_size*sizeof(double)); // DO NOT DELETE... you must initialize to 0 to avoid getting something like 0.0*NaN and corrupting the solve
-      for(fineBox=0;fineBox<numFineBoxes;fineBox++)if(fineBoxes[fineBox].recvRank==fineRanks[neighbor]){
+      for(fineBox=0;fineBox<numFineBoxes;fineBox++)if( (fineBoxes[fineBox].recvRank==fineRanks[neighbor]) && all_grids->levels[level]->interpolation.send_coarse ){
+        // pack the MPI send buffer with the coarse sub-brick and its halo...
+        append_block_to_list(&(all_grids->levels[level]->interpolation.blocks[0]),&(all_grids->levels[level]->interpolation.allocated_blocks[0]),&(all_grids->levels[level]->interpolation.num_blocks[0]),
+          /* dim.i         = */ haloDim,
+          /* dim.j         = */ haloDim,
+          /* dim.k         = */ haloDim,
+          /* read.box      = */ fineBoxes[fineBox].sendBox,
+          /* read.ptr      = */ NULL,
+          /* read.i        = */ fineBoxes[fineBox].i-halo,
+          /* read.j        = */ fineBoxes[fineBox].j-halo,
+          /* read.k        = */ fineBoxes[fineBox].k-halo,
+          /* read.jStride  = */ all_grids->levels[level]->my_boxes[fineBoxes[fineBox].sendBox].jStride,
+          /* read.kStride  = */ all_grids->levels[level]->my_boxes[fineBoxes[fineBox].sendBox].kStride,
+          /* read.scale    = */ 1,
+          /* write.box     = */ -1,
+          /* write.ptr     = */ all_grids->levels[level]->interpolation.send_buffers[neighbor],
+          /* write.i       = */ offset,
+          /* write.j       = */ 0,
+          /* write.k       = */ 0,
+          /* write.jStride = */ haloDim,
+          /* write.kStride = */ haloDim*haloDim,
+          /* write.scale   = */ 1,
+          /* blockcopy_i   = */ BLOCKCOPY_TILE_I, // default
+          /* blockcopy_j   = */ BLOCKCOPY_TILE_J, // default
+          /* blockcopy_k   = */ BLOCKCOPY_TILE_K, // default
+          /* subtype       = */ 0,
+	  /* access policy = */ all_grids->levels[level]->um_access_policy
+        );
+        offset+=elementSize;
+      }else if(fineBoxes[fineBox].recvRank==fineRanks[neighbor]){
         // pack the MPI send buffer...
         append_block_to_list(&(all_grids->levels[level]->interpolation.blocks[0]),&(all_grids->levels[level]->interpolation.allocated_blocks[0]),&(all_grids->levels[level]->interpolation.num_blocks[0]),
           /* dim.i         = */ all_grids->levels[level-1]->box_dim/2,
@@ -362,8 +1047,19 @@ void build_interpolation(mg_type *all_grids){
     }
 
     int elementSize = all_grids->levels[level]->box_dim*all_grids->levels[level]->box_dim*all_grids->levels[level]->box_dim;
+    int halo        = 0;
+    int haloDim     = all_grids->levels[level]->box_dim/2;
+    if(all_grids->levels[level]->interpolation.recv_coarse){
+      halo        = interpolation_halo(all_grids->levels[level+1]);
+      haloDim     = all_grids->levels[level]->box_dim/2 + 2*halo;
+      elementSize = haloDim*haloDim*haloDim;
+    }
     //printf("level=%d, rank=%2d, recv_buffers=%6d\n",level,all_grids->my_rank,numCoarseBoxes*elementSize*sizeof(double));
 
+    // size the unpack list exactly...
+    int unpackDim = all_grids->levels[level]->interpolation.recv_coarse ? all_grids->levels[level]->box_dim/2 : all_grids->levels[level]->box_dim;
+    reserve_blocks_in_list(&(all_grids->levels[level]->interpolation.blocks[2]),&(all_grids->levels[level]->interpolation.allocated_blocks[2]),numCoarseBoxes*blocks_in_region(unpackDim,unpackDim,unpackDim,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K),all_grids->levels[level]->um_access_policy);
+
     // for each neighbor, construct the unpack list and allocate the MPI recv buffer... 
     for(neighbor=0;neighbor<numCoarseRanks;neighbor++){
       int coarseBox;
@@ -373,7 +1069,36 @@ void build_interpolation(mg_type *all_grids){
              all_grids->levels[level]->interpolation.recv_buffers[neighbor] = (double*)um_malloc(malloc_size*sizeof(double),UM_ACCESS_BOTH); 
           if(all_grids->levels[level]->interpolation.recv_buffers[neighbor]==NULL){fprintf(stderr,"malloc failed - interpolation/all_recv_buffers\n");exit(0);}
       memset(all_grids->levels[level]->interpolation.recv_buffers[neighbor],0,malloc_size*sizeof(double)); // DO NOT DELETE... you must initialize to 0 to avoid getting something like 0.0*NaN and corrupting the solve
-      for(coarseBox=0;coarseBox<numCoarseBoxes;coarseBox++)if(coarseBoxes[coarseBox].sendRank==coarseRanks[neighbor]){
+      for(coarseBox=0;coarseBox<numCoarseBoxes;coarseBox++)if( (coarseBoxes[coarseBox].sendRank==coarseRanks[neighbor]) && all_grids->levels[level]->interpolation.recv_coarse ){
+        // interpolate from the coarse sub-brick in the MPI recv buffer...
+        append_block_to_list(&(all_grids->levels[level]->interpolation.blocks[2]),&(all_grids->levels[level]->interpolation.allocated_blocks[2]),&(all_grids->levels[level]->interpolation.num_blocks[2]),
+          /* dim.i         = */ all_grids->levels[level]->box_dim/2,
+          /* dim.j         = */ all_grids->levels[level]->box_dim/2,
+          /* dim.k         = */ all_grids->levels[level]->box_dim/2,
+          /* read.box      = */ -1,
+          /* read.ptr      = */ all_grids->levels[level]->interpolation.recv_buffers[neighbor],
+          /* read.i        = */ offset+halo,
+          /* read.j        = */ halo,
+          /* read.k        = */ halo,
+          /* read.jStride  = */ haloDim,
+          /* read.kStride  = */ haloDim*haloDim,
+          /* read.scale    = */ 1,
+          /* write.box     = */ coarseBoxes[coarseBox].recvBox,
+          /* write.ptr     = */ NULL,
+          /* write.i       = */ 0,
+          /* write.j       = */ 0,
+          /* write.k       = */ 0,
+          /* write.jStride = */ all_grids->levels[level]->my_boxes[coarseBoxes[coarseBox].recvBox].jStride,
+          /* write.kStride = */ all_grids->levels[level]->my_boxes[coarseBoxes[coarseBox].recvBox].kStride,
+          /* write.scale   = */ 2,
+          /* blockcopy_i   = */ BLOCKCOPY_TILE_I, // default
+          /* blockcopy_j   = */ BLOCKCOPY_TILE_J, // default
+          /* blockcopy_k   = */ BLOCKCOPY_TILE_K, // default
+          /* subtype       = */ 0,
+	  /* access policy = */ all_grids->levels[level]->um_access_policy
+        );
+        offset+=elementSize;
+      }else if(coarseBoxes[coarseBox].sendRank==coarseRanks[neighbor]){
         // unpack MPI recv buffer...
         append_block_to_list(&(all_grids->levels[level]->interpolation.blocks[2]),&(all_grids->levels[level]->interpolation.allocated_blocks[2]),&(all_grids->levels[level]->interpolation.num_blocks[2]),
           /* dim.i         = */ all_grids->levels[level]->box_dim,
@@ -417,6 +1142,11 @@ void build_interpolation(mg_type *all_grids){
   } // all levels
 
 
+  for(level=0;level<all_grids->num_levels;level++){
+    group_blocks_by_buffer(&all_grids->levels[level]->interpolation);
+  }
+
+
   #ifdef USE_MPI
   for(level=0;level<all_grids->num_levels;level++){
     all_grids->levels[level]->interpolation.requests = NULL;
@@ -490,7 +1220,7 @@ void build_restriction(mg_type *all_grids, int restrictionType){
       int coarseBox_j = fineBox_j*all_grids->levels[level+1]->boxes_in.j/all_grids->levels[level]->boxes_in.j;
       int coarseBox_k = fineBox_k*all_grids->levels[level+1]->boxes_in.k/all_grids->levels[level]->boxes_in.k;
       int coarseBoxID =  coarseBox_i + coarseBox_j*all_grids->levels[level+1]->boxes_in.i + coarseBox_k*all_grids->levels[level+1]->boxes_in.i*all_grids->levels[level+1]->boxes_in.j;
-      int coarseBox   = -1;int c;for(c=0;c<all_grids->levels[level+1]->num_my_boxes;c++)if( all_grids->levels[level+1]->my_boxes[c].global_box_id == coarseBoxID )coarseBox=c; // try and find the coarseBox index of a box with global_box_id == coaseBoxID
+      int coarseBox   = all_grids->levels[level+1]->box_of_id[coarseBoxID]; // -1 if off-node
       coarseBoxes[numCoarseBoxes].sendRank  = all_grids->levels[level  ]->rank_of_box[  fineBoxID];
       coarseBoxes[numCoarseBoxes].sendBoxID = fineBoxID;
       coarseBoxes[numCoarseBoxes].sendBox   = fineBox;
@@ -544,6 +1274,10 @@ void build_restriction(mg_type *all_grids, int restrictionType){
                              restrict_dim_k = (1+all_grids->levels[level]->box_dim/2);break;
     }
     elementSize = restrict_dim_i*restrict_dim_j*restrict_dim_k;
+
+    // size the pack and local lists exactly...
+    reserve_blocks_in_list(&(all_grids->levels[level]->restriction[restrictionType].blocks[0]),&(all_grids->levels[level]->restriction[restrictionType].allocated_blocks[0]),numCoarseBoxesRemote*blocks_in_region(restrict_dim_i,restrict_dim_j,restrict_dim_k,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K),all_grids->levels[level]->um_access_policy);
+    reserve_blocks_in_list(&(all_grids->levels[level]->restriction[restrictionType].blocks[1]),&(all_grids->levels[level]->restriction[restrictionType].allocated_blocks[1]),numCoarseBoxesLocal *blocks_in_region(restrict_dim_i,restrict_dim_j,restrict_dim_k,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K),all_grids->levels[level]->um_access_policy);
    
     // for each neighbor, construct the pack list and allocate the MPI send buffer... 
     for(neighbor=0;neighbor<numCoarseRanks;neighbor++){
@@ -714,6 +1448,9 @@ void build_restriction(mg_type *all_grids, int restrictionType){
 
     //printf("level=%d, rank=%2d, recv_buffers=%6d\n",level,all_grids->my_rank,numFineBoxesRemote*elementSize*sizeof(double));
 
+    // size the unpack list exactly...
+    reserve_blocks_in_list(&(all_grids->levels[level]->restriction[restrictionType].blocks[2]),&(all_grids->levels[level]->restriction[restrictionType].allocated_blocks[2]),numFineBoxesRemote*blocks_in_region(restrict_dim_i,restrict_dim_j,restrict_dim_k,BLOCKCOPY_TILE_I,BLOCKCOPY_TILE_J,BLOCKCOPY_TILE_K),all_grids->levels[level]->um_access_policy);
+
     // for each neighbor, construct the unpack list and allocate the MPI recv buffer... 
     for(neighbor=0;neighbor<numFineRanks;neighbor++){
       int fineBox;
@@ -770,6 +1507,11 @@ void build_restriction(mg_type *all_grids, int restrictionType){
   } // level loop
 
 
+  for(level=0;level<all_grids->num_levels;level++){
+    group_blocks_by_buffer(&all_grids->levels[level]->restriction[restrictionType]);
+  }
+
+
   #ifdef USE_MPI
   for(level=0;level<all_grids->num_levels;level++){
     all_grids->levels[level]->restriction[restrictionType].requests = NULL;
@@ -785,38 +1527,101 @@ void build_restriction(mg_type *all_grids, int restrictionType){
 }
 
 
+//------------------------------------------------------------------------------------------------------------------------------
+// --high-order-levels=N counts the N high-order levels from the level a solve starts on (the Richardson analysis in hpgmg-fv.c solves from levels 0, 1 and 2)
+// levels whose operator variant changes rebuild D^{-1}, l1^{-1}, and lambda_max (a Lanczos estimate reverts to the Gershgorin bound)
+#ifndef HIGH_ORDER_MAX_ONLEVEL
+#define HIGH_ORDER_MAX_ONLEVEL 2 // deepest level a solve starts on... levels coarser than N+HIGH_ORDER_MAX_ONLEVEL are always low order and get 1 ghost zone
+#endif
+void MGSetLowOrderLevels(mg_type *all_grids, int onLevel, double a, double b){
+  int level;
+  if(all_grids->options.high_order_levels<=0)return;
+  for(level=onLevel;level<all_grids->num_levels;level++){
+    level_type *l = all_grids->levels[level];
+    int low_order = (level>=onLevel+all_grids->options.high_order_levels);
+    if(low_order==l->low_order)continue;
+    if(!low_order && (l->box_ghosts<stencil_get_radius())){fprintf(stderr,"--high-order-levels... a solve on level %d needs the high-order operator on level %d which has only %d ghost zone(s) (see HIGH_ORDER_MAX_ONLEVEL)\n",onLevel,level,l->box_ghosts);exit(0);}
+    l->low_order = low_order;
+    rebuild_operator(l,NULL,a,b);
+    l->smallest_eigenvalue_of_DinvA = 0.0;
+    if(l->chebyshev_c1){um_free(l->chebyshev_c1,l->um_access_policy);l->chebyshev_c1=NULL;}
+    if(l->chebyshev_c2){um_free(l->chebyshev_c2,l->um_access_policy);l->chebyshev_c2=NULL;}
+  }
+}
+
+
 //------------------------------------------------------------------------------------------------------------------------------
 // given a fine grid input, build a hiearchy of MG levels
 // level 0 simply points to fine_grid.  All other levels are created
 // rebuild the restriction/interpolation lists for each coarse grid level
 // rebuild the operator on each coarse grid level
 // add extra vectors to the coarse grid once here instead of on every call to the coarse grid solve
-// NOTE, this routine presumes the fine_grid domain is cubical... fine_grid->dim.i==fine_grid->dim.j==fine_grid->dim.k
+// NOTE, the fine_grid domain need not be cubical, but every level is coarsened by 2 in each dimension.  Thus the depth is limited by the dimension with the fewest factors of 2
 // NOTE, as this function is not timed, it has not been optimzied for performance
-void MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int minCoarseGridDim){
+// options may be NULL in which case the compile-time defaults are used
+void MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int minCoarseGridDim, mg_options_type *options){
   int  maxLevels=100; // i.e. maximum problem size is (2^100)^3
   int     nProcs[100];
   int      dim_i[100];
   int boxes_in_i[100];
+  int boxes_in_j[100];
+  int boxes_in_k[100];
   int    box_dim[100];
   int box_ghosts[100];
   all_grids->my_rank = fine_grid->my_rank;
-  all_grids->timers.MGBuild = 0;
+  all_grids->timers.MGBuild          = 0;
+  all_grids->timers.MGBuild_levels   = 0;
+  all_grids->timers.MGBuild_lists    = 0;
+  all_grids->timers.MGBuild_subcomm  = 0;
+  all_grids->timers.MGBuild_operator = 0;
+  all_grids->timers.MGBuild_tune     = 0;
+  if(options)all_grids->options = *options;
+        else MGDefaultOptions(&all_grids->options);
   double _timeStartMGBuild = getTime();
 
+  // constant coefficients... coarser levels (created with fine_grid as an ancestor) then allocate no coefficient vectors
+  if(all_grids->options.constant_coefficients){
+    double alpha,beta;
+    int constant = MGDetectConstantCoefficients(fine_grid,a,&alpha,&beta);
+    if(!constant && (all_grids->options.constant_coefficients>0)){
+      if(all_grids->my_rank==0){fprintf(stderr,"  WARNING... alpha and the beta's are not constant (--constant-coefficients is ignored)\n");}
+    }
+    if(constant && !stencil_supports_constant_coefficients()){
+      if(all_grids->my_rank==0){fprintf(stderr,"  WARNING... this operator has no constant-coefficient implementation\n");}
+      constant=0;
+    }
+    if(constant){
+      if(all_grids->my_rank==0){fprintf(stdout,"  using the constant-coefficient operator (alpha=%e, beta's=%e)\n",alpha,beta);fflush(stdout);}
+      fine_grid->constant_coefficients = 1;
+      fine_grid->constant_alpha = alpha;
+      fine_grid->constant_beta  = beta;
+      release_coefficient_vectors(fine_grid);
+      if(!fine_grid->use_cuda)rebuild_operator(fine_grid,NULL,a,b); // GPU levels keep (and use) their coefficient vectors
+    }
+  }
+
   // calculate how deep we can make the v-cycle...
   int level=1;
-                             int coarse_dim = fine_grid->dim.i;
-//if(fine_grid->dim.j<coarse_dim)coarse_dim = fine_grid->dim.j;
-//if(fine_grid->dim.k<coarse_dim)coarse_dim = fine_grid->dim.k;
-  while( (coarse_dim>=2*minCoarseGridDim) && ((coarse_dim&0x1)==0) ){ // grid dimension is even and big enough...
+  int coarse_dim_i = fine_grid->dim.i;
+  int coarse_dim_j = fine_grid->dim.j;
+  int coarse_dim_k = fine_grid->dim.k;
+  while( (coarse_dim_i>=2*minCoarseGridDim) && ((coarse_dim_i&0x1)==0) &&
+         (coarse_dim_j>=2*minCoarseGridDim) && ((coarse_dim_j&0x1)==0) &&
+         (coarse_dim_k>=2*minCoarseGridDim) && ((coarse_dim_k&0x1)==0) ){ // every grid dimension is even and big enough...
     level++;
-    coarse_dim = coarse_dim / 2;
+    coarse_dim_i = coarse_dim_i / 2;
+    coarse_dim_j = coarse_dim_j / 2;
+    coarse_dim_k = coarse_dim_k / 2;
   }if(level<maxLevels)maxLevels=level;
+  int coarse_dim = coarse_dim_i; // largest dimension of the coarsest grid
+  if(coarse_dim_j>coarse_dim)coarse_dim = coarse_dim_j;
+  if(coarse_dim_k>coarse_dim)coarse_dim = coarse_dim_k;
 
       nProcs[0] = fine_grid->num_ranks;
        dim_i[0] = fine_grid->dim.i;
   boxes_in_i[0] = fine_grid->boxes_in.i;
+  boxes_in_j[0] = fine_grid->boxes_in.j;
+  boxes_in_k[0] = fine_grid->boxes_in.k;
      box_dim[0] = fine_grid->box_dim;
   box_ghosts[0] = fine_grid->box_ghosts;
 
@@ -829,105 +1634,173 @@ void MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int
 
   // build a table to guide the construction of the v-cycle...
   int doRestrict=1;if(maxLevels<2)doRestrict=0; // i.e. can't restrict if there is only one level !!!
-  #ifdef USE_UCYCLES
-  while(doRestrict){
-    level = all_grids->num_levels;
-    doRestrict=0;
-    if( (box_dim[level-1] % 2 == 0) ){
-          nProcs[level] =     nProcs[level-1];
-           dim_i[level] =      dim_i[level-1]/2;
-         box_dim[level] =    box_dim[level-1]/2;
-      boxes_in_i[level] = boxes_in_i[level-1];
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
+  if(all_grids->options.cycle==MG_CYCLE_U){
+    while(doRestrict){
+      level = all_grids->num_levels;
+      doRestrict=0;
+      if( (box_dim[level-1] % 2 == 0) ){
+            nProcs[level] =     nProcs[level-1];
+             dim_i[level] =      dim_i[level-1]/2;
+           box_dim[level] =    box_dim[level-1]/2;
+        boxes_in_i[level] = boxes_in_i[level-1];
+        boxes_in_j[level] = boxes_in_j[level-1];
+        boxes_in_k[level] = boxes_in_k[level-1];
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }
+      if(box_dim[level] < stencil_get_radius())doRestrict=0;
+      if( (dim_i[level]<minCoarseGridDim) || (level>=maxLevels) )doRestrict=0;
+      if(doRestrict)all_grids->num_levels++;
     }
-    if(box_dim[level] < box_ghosts[level])doRestrict=0;
-    if(dim_i[level]<minCoarseGridDim)doRestrict=0;
-    if(doRestrict)all_grids->num_levels++;
-  }
-  #else // TRUE V-Cycle...
-  while(doRestrict){
-    level = all_grids->num_levels;
-    doRestrict=0;
-    int fine_box_dim    =    box_dim[level-1];
-    int fine_nProcs     =     nProcs[level-1];
-    int fine_dim_i      =      dim_i[level-1];
-    int fine_boxes_in_i = boxes_in_i[level-1];
-    if( (fine_box_dim % 2 == 0) && (fine_box_dim > MG_AGGLOMERATION_START) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // Boxes are too big to agglomerate
-          nProcs[level] = fine_nProcs;
-           dim_i[level] = fine_dim_i/2;
-         box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
-      boxes_in_i[level] = fine_boxes_in_i;
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
-    }else
-    if( (fine_boxes_in_i % 2 == 0) && ((fine_box_dim)>=stencil_get_radius()) ){ // 8:1 box agglomeration
-          nProcs[level] = fine_nProcs;
-           dim_i[level] = fine_dim_i/2;
-         box_dim[level] = fine_box_dim;
-      boxes_in_i[level] = fine_boxes_in_i/2;
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
-    }else
-    if( (coarse_dim != 1) && (fine_dim_i == 2*coarse_dim) && ((fine_dim_i/2)>=stencil_get_radius()) ){ // agglomerate everything
-          nProcs[level] = 1;
-           dim_i[level] = fine_dim_i/2;
-         box_dim[level] = fine_dim_i/2; // FIX, verify its not less than the stencil radius
-      boxes_in_i[level] = 1;
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
-    }else
-    if( (coarse_dim != 1) && (fine_dim_i == 4*coarse_dim) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // restrict box dimension, and run on fewer ranks
-          nProcs[level] = coarse_dim<fine_nProcs ? coarse_dim : fine_nProcs;
-           dim_i[level] = fine_dim_i/2;
-         box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
-      boxes_in_i[level] = fine_boxes_in_i;
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
-    }else
-    if( (coarse_dim != 1) && (fine_dim_i == 8*coarse_dim) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // restrict box dimension, and run on fewer ranks
-          nProcs[level] = coarse_dim*coarse_dim<fine_nProcs ? coarse_dim*coarse_dim : fine_nProcs;
-           dim_i[level] = fine_dim_i/2;
-         box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
-      boxes_in_i[level] = fine_boxes_in_i;
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
-    }else
-    if( (fine_box_dim % 2 == 0) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // restrict box dimension, and run on the same number of ranks
-          nProcs[level] = fine_nProcs;
-           dim_i[level] = fine_dim_i/2;
-         box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
-      boxes_in_i[level] = fine_boxes_in_i;
-      box_ghosts[level] = box_ghosts[level-1];
-             doRestrict = 1;
+  }else{ // TRUE V-Cycle...
+    while(doRestrict){
+      level = all_grids->num_levels;
+      doRestrict=0;
+      int fine_box_dim    =    box_dim[level-1];
+      int fine_nProcs     =     nProcs[level-1];
+      int fine_dim_i      =      dim_i[level-1];
+      int fine_boxes_in_i = boxes_in_i[level-1];
+      int fine_boxes_in_j = boxes_in_j[level-1];
+      int fine_boxes_in_k = boxes_in_k[level-1];
+      int boxes_gcd = fine_boxes_in_i; // largest agglomeration of boxes that still tiles the domain in every dimension
+      while( (fine_boxes_in_j%boxes_gcd) || (fine_boxes_in_k%boxes_gcd) )boxes_gcd--;
+      int boxes_are_even = (fine_boxes_in_i % 2 == 0) && (fine_boxes_in_j % 2 == 0) && (fine_boxes_in_k % 2 == 0);
+      // boxes of odd dimension can't be restricted.  Rather than truncate the v-cycle there, agglomerate before box_dim becomes odd (e.g. 40->20->10 then 8:1 agglomeration)
+      int odd_box_dim_next = ((fine_box_dim/2) % 2 == 1) && (fine_dim_i != 2*coarse_dim_i);
+      if( (fine_box_dim % 2 == 0) && (fine_box_dim > MG_AGGLOMERATION_START) && ((fine_box_dim/2)>=stencil_get_radius()) && !(odd_box_dim_next && boxes_are_even) ){ // Boxes are too big to agglomerate
+            nProcs[level] = fine_nProcs;
+             dim_i[level] = fine_dim_i/2;
+           box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
+        boxes_in_i[level] = fine_boxes_in_i;
+        boxes_in_j[level] = fine_boxes_in_j;
+        boxes_in_k[level] = fine_boxes_in_k;
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }else
+      if( boxes_are_even && (fine_box_dim % 2 == 0) && ((fine_box_dim)>=stencil_get_radius()) ){ // 8:1 box agglomeration
+            nProcs[level] = fine_nProcs;
+             dim_i[level] = fine_dim_i/2;
+           box_dim[level] = fine_box_dim;
+        boxes_in_i[level] = fine_boxes_in_i/2;
+        boxes_in_j[level] = fine_boxes_in_j/2;
+        boxes_in_k[level] = fine_boxes_in_k/2;
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }else
+      if( (coarse_dim != 1) && (fine_dim_i == 2*coarse_dim_i) && (fine_box_dim % 2 == 0) && ((boxes_gcd*fine_box_dim/2)>=stencil_get_radius()) ){ // agglomerate everything (onto as few boxes as the shape of the domain allows)
+            nProcs[level] = 1;
+             dim_i[level] = fine_dim_i/2;
+           box_dim[level] = boxes_gcd*fine_box_dim/2; // FIX, verify its not less than the stencil radius
+        boxes_in_i[level] = fine_boxes_in_i/boxes_gcd;
+        boxes_in_j[level] = fine_boxes_in_j/boxes_gcd;
+        boxes_in_k[level] = fine_boxes_in_k/boxes_gcd;
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }else
+      if( (coarse_dim != 1) && (fine_dim_i == 4*coarse_dim_i) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // restrict box dimension, and run on fewer ranks
+            nProcs[level] = coarse_dim<fine_nProcs ? coarse_dim : fine_nProcs;
+             dim_i[level] = fine_dim_i/2;
+           box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
+        boxes_in_i[level] = fine_boxes_in_i;
+        boxes_in_j[level] = fine_boxes_in_j;
+        boxes_in_k[level] = fine_boxes_in_k;
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }else
+      if( (coarse_dim != 1) && (fine_dim_i == 8*coarse_dim_i) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // restrict box dimension, and run on fewer ranks
+            nProcs[level] = coarse_dim*coarse_dim<fine_nProcs ? coarse_dim*coarse_dim : fine_nProcs;
+             dim_i[level] = fine_dim_i/2;
+           box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
+        boxes_in_i[level] = fine_boxes_in_i;
+        boxes_in_j[level] = fine_boxes_in_j;
+        boxes_in_k[level] = fine_boxes_in_k;
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }else
+      if( (fine_box_dim % 2 == 0) && ((fine_box_dim/2)>=stencil_get_radius()) ){ // restrict box dimension, and run on the same number of ranks
+            nProcs[level] = fine_nProcs;
+             dim_i[level] = fine_dim_i/2;
+           box_dim[level] = fine_box_dim/2; // FIX, verify its not less than the stencil radius
+        boxes_in_i[level] = fine_boxes_in_i;
+        boxes_in_j[level] = fine_boxes_in_j;
+        boxes_in_k[level] = fine_boxes_in_k;
+        box_ghosts[level] = box_ghosts[level-1];
+               doRestrict = 1;
+      }
+      if( (dim_i[level]<minCoarseGridDim) || (level>=maxLevels) )doRestrict=0;
+      if(doRestrict)all_grids->num_levels++;
     }
-    if(dim_i[level]<minCoarseGridDim)doRestrict=0;
-    if(doRestrict)all_grids->num_levels++;
   }
-  #endif
 
 
+  // levels coarser than --high-order-levels use the operator's 2nd order variant which needs only 1 ghost zone...
+  // the N finest levels are counted from the level a solve starts from (see MGSetLowOrderLevels)... only levels that are low order for every onLevel<=HIGH_ORDER_MAX_ONLEVEL get 1 ghost zone
+  if( (all_grids->options.high_order_levels>0) && !stencil_supports_low_order() ){
+    if(all_grids->my_rank==0){fprintf(stderr,"  WARNING... this operator has no 2nd order variant (--high-order-levels is ignored)\n");}
+    all_grids->options.high_order_levels = 0;
+  }
+  if(all_grids->options.high_order_levels>0)
+  for(level=all_grids->options.high_order_levels+HIGH_ORDER_MAX_ONLEVEL;level<all_grids->num_levels;level++)box_ghosts[level]=1;
+
+  // deep ghost zones for the communication-avoiding chebyshev smoother... never deeper than a box (ghost zones are filled by the adjacent boxes)
+  if(all_grids->options.num_chebyshev_steps>0)
+  for(level=1;level<all_grids->num_levels;level++){
+    box_ghosts[level] = stencil_get_radius()*MGChebyshevSteps(&all_grids->options,level);
+    if(box_ghosts[level]>box_dim[level])box_ghosts[level]=box_dim[level];
+    if(box_ghosts[level]<stencil_get_radius())box_ghosts[level]=stencil_get_radius();
+  }
+
   // now build all the coarsened levels...
+  double _timeStart = getTime();
   for(level=1;level<all_grids->num_levels;level++){
     all_grids->levels[level] = (level_type*)malloc(sizeof(level_type));
     if(all_grids->levels[level] == NULL){fprintf(stderr,"malloc failed - MGBuild/doRestrict\n");exit(0);}
-    create_level(all_grids->levels[level],boxes_in_i[level],box_dim[level],box_ghosts[level],all_grids->levels[level-1]->numVectors,all_grids->levels[level-1]->boundary_condition.type,all_grids->levels[level-1]->my_rank,nProcs[level],all_grids->levels[level-1]);
+    create_level(all_grids->levels[level],boxes_in_i[level],boxes_in_j[level],boxes_in_k[level],box_dim[level],box_ghosts[level],all_grids->levels[level-1]->numVectors,all_grids->levels[level-1]->boundary_condition.type,all_grids->levels[level-1]->my_rank,nProcs[level],all_grids->levels[level-1]);
     all_grids->levels[level]->h = 2.0*all_grids->levels[level-1]->h;
+    if( (all_grids->options.high_order_levels>0) && (level>=all_grids->options.high_order_levels) ){
+      if(all_grids->levels[level]->use_cuda){fprintf(stderr,"--high-order-levels... level %d runs on the GPU which only supports the high-order operator\n",level);exit(0);}
+      all_grids->levels[level]->low_order = 1;
+    }
+  }
+  all_grids->timers.MGBuild_levels += (double)(getTime()-_timeStart);
+
+
+  // select the smoother for each level and the bottom solver...
+  for(level=0;level<all_grids->num_levels;level++){
+    int s = (level<all_grids->options.num_smoothers) ? level : all_grids->options.num_smoothers-1;
+    all_grids->levels[level]->smoother      = all_grids->options.smoothers[s];
+    all_grids->levels[level]->bottom_solver = all_grids->options.bottom_solver;
+    int steps = MGChebyshevSteps(&all_grids->options,level);
+    int halo  = all_grids->levels[level]->box_ghosts/stencil_get_radius(); // steps the ghost zones can support
+    all_grids->levels[level]->chebyshev_steps = (steps<halo) ? steps : halo;
+    if( (all_grids->levels[level]->use_cuda) && (all_grids->levels[level]->smoother != smoother_get_default()) ){
+      // the CUDA kernels only implement the smoother selected at compile time
+      if(all_grids->my_rank==0)fprintf(stderr,"  WARNING... level %d runs on the GPU which only supports the '%s' smoother\n",level,smoother_get_name(smoother_get_default()));
+      all_grids->levels[level]->smoother = smoother_get_default();
+    }
   }
 
 
   // bottom solver (level = all_grids->num_levels-1) gets extra vectors...
-  create_vectors(all_grids->levels[all_grids->num_levels-1],all_grids->levels[all_grids->num_levels-1]->numVectors + IterativeSolver_NumVectors() );
+  create_vectors(all_grids->levels[all_grids->num_levels-1],all_grids->levels[all_grids->num_levels-1]->numVectors + IterativeSolver_NumVectors(all_grids->options.bottom_solver) );
+
+  // as do the (non-bottom) coarse levels whose corrections are K-cycles...
+  if(all_grids->options.kcycle)
+  for(level=1;level<all_grids->num_levels-1;level++){
+    if(MGCycleIndex(&all_grids->options,level-1)==2)create_vectors(all_grids->levels[level],VECTOR_KCYCLE_V2+1);
+  }
 
 
   // build the restriction and interpolation communicators...
   if(all_grids->my_rank==0){fprintf(stdout,"\n  Building restriction and interpolation lists... ");fflush(stdout);}
+  _timeStart = getTime();
   build_restriction(all_grids,RESTRICT_CELL  ); // cell-centered
   build_restriction(all_grids,RESTRICT_FACE_I); // face-centered, normal to i
   build_restriction(all_grids,RESTRICT_FACE_J); // face-centered, normal to j
   build_restriction(all_grids,RESTRICT_FACE_K); // face-centered, normal to k
   build_interpolation(all_grids);
-  if(all_grids->my_rank==0){fprintf(stdout,"done\n");fflush(stdout);}
+  all_grids->timers.MGBuild_lists += (double)(getTime()-_timeStart);
+  if(all_grids->my_rank==0){fprintf(stdout,"done (%0.6f seconds)\n",all_grids->timers.MGBuild_lists);fflush(stdout);}
 
 
   // build subcommunicators...
@@ -942,6 +1815,7 @@ void MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int
     MPI_Comm_split(MPI_COMM_WORLD,all_grids->levels[level]->active,all_grids->levels[level]->my_rank,&all_grids->levels[level]->MPI_COMM_ALLREDUCE);
     double comm_split_end = MPI_Wtime();
     double comm_split_time_send = comm_split_end-comm_split_start;
+    all_grids->timers.MGBuild_subcomm += comm_split_time_send;
     double comm_split_time = 0;
     MPI_Allreduce(&comm_split_time_send,&comm_split_time,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
     if(all_grids->my_rank==0){fprintf(stdout,"done (%0.6f seconds)\n",comm_split_time);fflush(stdout);}
@@ -951,20 +1825,35 @@ void MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int
 
   // rebuild various coefficients for the operator... must occur after build_restriction !!!
   if(all_grids->my_rank==0){fprintf(stdout,"\n");}
+  _timeStart = getTime();
   for(level=1;level<all_grids->num_levels;level++){
     rebuild_operator(all_grids->levels[level],(level>0)?all_grids->levels[level-1]:NULL,a,b);
   }
+  all_grids->timers.MGBuild_operator += (double)(getTime()-_timeStart);
   if(all_grids->my_rank==0){fprintf(stdout,"\n");}
 
 
   // quick tests for Poisson, Neumann, etc...
   for(level=0;level<all_grids->num_levels;level++){
     all_grids->levels[level]->must_subtract_mean = 0;
-    int alpha_is_zero = (dot(all_grids->levels[level],VECTOR_ALPHA,VECTOR_ALPHA) == 0.0);
+    int alpha_is_zero = all_grids->levels[level]->constant_coefficients ? (all_grids->levels[level]->constant_alpha==0.0) : (dot(all_grids->levels[level],VECTOR_ALPHA,VECTOR_ALPHA) == 0.0);
     // For Poisson with Periodic Boundary Conditions, by convention we assume the solution sums to zero.  Eliminate any constants from the solution by subtracting the mean.
     if( (all_grids->levels[level]->boundary_condition.type==BC_PERIODIC) && ((a==0) || (alpha_is_zero==1)) )all_grids->levels[level]->must_subtract_mean = 1;
   }
 
+
+  // choose the tiling of each level's boxes into blocks...
+  _timeStart = getTime();
+  if(all_grids->options.lanczos_iterations>0)MGEstimateEigenvalues(all_grids,a,b);
+  if(all_grids->options.smoother_target>0.0)MGTuneSmoothers(all_grids,a,b);
+  #ifdef CHEBYSHEV_CA_CHECK
+  if(all_grids->options.num_chebyshev_steps>0)MGCheckChebyshevSteps(all_grids,a,b);
+  #endif
+  #ifdef USE_TILE_AUTOTUNE
+  MGTuneTiles(all_grids,a,b);
+  #endif
+  all_grids->timers.MGBuild_tune += (double)(getTime()-_timeStart);
+
   cudaDeviceSynchronize();  // synchronize GPU at the end of the setup phase
   all_grids->timers.MGBuild += (double)(getTime()-_timeStartMGBuild);
 }
@@ -986,6 +1875,7 @@ void MGDestroy(mg_type *all_grids){
       if(all_grids->levels[level]->restriction[i].recv_buffers   )free(all_grids->levels[level]->restriction[i].recv_buffers   );
       if(all_grids->levels[level]->restriction[i].recv_ranks     )free(all_grids->levels[level]->restriction[i].recv_ranks     );
       if(all_grids->levels[level]->restriction[i].recv_sizes     )free(all_grids->levels[level]->restriction[i].recv_sizes     );
+      if(all_grids->levels[level]->restriction[i].unpack_start   )free(all_grids->levels[level]->restriction[i].unpack_start   );
       }
       if(all_grids->levels[level]->restriction[i].num_sends>0){
       for(j=0;j<all_grids->levels[level]->restriction[i].num_sends;j++)if(all_grids->levels[level]->restriction[i].send_buffers[j])um_free(all_grids->levels[level]->restriction[i].send_buffers[j], UM_ACCESS_BOTH);
@@ -993,6 +1883,7 @@ void MGDestroy(mg_type *all_grids){
       if(all_grids->levels[level]->restriction[i].send_buffers   )free(all_grids->levels[level]->restriction[i].send_buffers   );
       if(all_grids->levels[level]->restriction[i].send_ranks     )free(all_grids->levels[level]->restriction[i].send_ranks     );
       if(all_grids->levels[level]->restriction[i].send_sizes     )free(all_grids->levels[level]->restriction[i].send_sizes     );
+      if(all_grids->levels[level]->restriction[i].pack_start     )free(all_grids->levels[level]->restriction[i].pack_start     );
       }
       if(all_grids->levels[level]->restriction[i].blocks[0]      )um_free(all_grids->levels[level]->restriction[i].blocks[0], all_grids->levels[level]->um_access_policy);
       if(all_grids->levels[level]->restriction[i].blocks[1]      )um_free(all_grids->levels[level]->restriction[i].blocks[1], all_grids->levels[level]->um_access_policy);
@@ -1010,6 +1901,7 @@ void MGDestroy(mg_type *all_grids){
     if(all_grids->levels[level]->interpolation.recv_buffers   )free(all_grids->levels[level]->interpolation.recv_buffers   );
     if(all_grids->levels[level]->interpolation.recv_ranks     )free(all_grids->levels[level]->interpolation.recv_ranks     );
     if(all_grids->levels[level]->interpolation.recv_sizes     )free(all_grids->levels[level]->interpolation.recv_sizes     );
+    if(all_grids->levels[level]->interpolation.unpack_start   )free(all_grids->levels[level]->interpolation.unpack_start   );
     }
     if(all_grids->levels[level]->interpolation.num_sends>0){
     for(j=0;j<all_grids->levels[level]->interpolation.num_sends;j++)if(all_grids->levels[level]->interpolation.send_buffers[j])um_free(all_grids->levels[level]->interpolation.send_buffers[j], UM_ACCESS_BOTH);
@@ -1017,6 +1909,7 @@ void MGDestroy(mg_type *all_grids){
     if(all_grids->levels[level]->interpolation.send_buffers   )free(all_grids->levels[level]->interpolation.send_buffers   );
     if(all_grids->levels[level]->interpolation.send_ranks     )free(all_grids->levels[level]->interpolation.send_ranks     );
     if(all_grids->levels[level]->interpolation.send_sizes     )free(all_grids->levels[level]->interpolation.send_sizes     );
+    if(all_grids->levels[level]->interpolation.pack_start     )free(all_grids->levels[level]->interpolation.pack_start     );
     }
     if(all_grids->levels[level]->interpolation.blocks[0]      )um_free(all_grids->levels[level]->interpolation.blocks[0], all_grids->levels[level]->um_access_policy);
     if(all_grids->levels[level]->interpolation.blocks[1]      )um_free(all_grids->levels[level]->interpolation.blocks[1], all_grids->levels[level]->um_access_policy);
@@ -1060,6 +1953,60 @@ void richardson_error(mg_type *all_grids, int levelh, int u_id){
 }
 
 
+//------------------------------------------------------------------------------------------------------------------------------
+#ifndef KCYCLE_THRESHOLD
+#define KCYCLE_THRESHOLD 0.25 // skip the second iteration if the first reduced ||r||_2 to this fraction of its initial value
+#endif
+void MGVCycle(mg_type *all_grids, int e_id, int R_id, double a, double b, int level);
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+// calculate the correction e (initially zero) on coarse level 'level' for the restricted residual R.  MGCycleIndex() of the next finer level selects...
+//   1 (V) one cycle on this level
+//   2 (W) two cycles (the second starts from the result of the first)
+//   2 with --kcycle, the two cycles precondition two iterations of flexible CG (Notay and Vassilevski's K-cycle).  R is overwritten.
+// The bottom level is always solved once.
+void MGCoarseCorrection(mg_type *all_grids, int e_id, int R_id, double a, double b, int level){
+  level_type *l = all_grids->levels[level];
+  int gamma = MGCycleIndex(&all_grids->options,level-1);
+  if( !l->active || (level==all_grids->num_levels-1) || (gamma<2) ){MGVCycle(all_grids,e_id,R_id,a,b,level);return;}
+  if(!all_grids->options.kcycle){
+    int g;for(g=0;g<gamma;g++)MGVCycle(all_grids,e_id,R_id,a,b,level);
+    return;
+  }
+
+  // first iteration... c = B r, e = (c,r)/(c,Ac) c
+  MGVCycle(all_grids,e_id,R_id,a,b,level);
+  double _LevelStart = getTime();
+  scale_vector(l,VECTOR_KCYCLE_C,1.0,e_id);
+  apply_op(l,VECTOR_KCYCLE_V1,VECTOR_KCYCLE_C,a,b);
+  double rho1   = dot(l,VECTOR_KCYCLE_C,VECTOR_KCYCLE_V1);
+  double alpha1 = dot(l,VECTOR_KCYCLE_C,R_id);
+  double r_dot_r = dot(l,R_id,R_id);
+  if(rho1<=0.0){l->timers.Total += (double)(getTime()-_LevelStart);return;} // keep the plain correction
+  add_vectors(l,R_id,1.0,R_id,-alpha1/rho1,VECTOR_KCYCLE_V1); // r = r - alpha1/rho1 Ac
+  if(dot(l,R_id,R_id) <= KCYCLE_THRESHOLD*KCYCLE_THRESHOLD*r_dot_r){
+    scale_vector(l,e_id,alpha1/rho1,VECTOR_KCYCLE_C);
+    l->timers.Total += (double)(getTime()-_LevelStart);
+    return;
+  }
+  zero_vector(l,e_id);
+  l->timers.Total += (double)(getTime()-_LevelStart);
+
+  // second iteration... d = B r (in e) is made A-orthogonal to c
+  MGVCycle(all_grids,e_id,R_id,a,b,level);
+  _LevelStart = getTime();
+  apply_op(l,VECTOR_KCYCLE_V2,e_id,a,b);
+  double gamma2 = dot(l,e_id,VECTOR_KCYCLE_V1);
+  double beta2  = dot(l,e_id,VECTOR_KCYCLE_V2);
+  double alpha2 = dot(l,e_id,R_id);
+  double rho2   = beta2 - gamma2*gamma2/rho1;
+  if(rho2>0.0)add_vectors(l,e_id,alpha1/rho1 - gamma2*alpha2/(rho1*rho2),VECTOR_KCYCLE_C,alpha2/rho2,e_id);
+         else scale_vector(l,e_id,alpha1/rho1,VECTOR_KCYCLE_C);
+  l->timers.Total += (double)(getTime()-_LevelStart);
+}
+
+
 //------------------------------------------------------------------------------------------------------------------------------
 void MGVCycle(mg_type *all_grids, int e_id, int R_id, double a, double b, int level){
   if(!all_grids->levels[level]->active)return;
@@ -1075,14 +2022,13 @@ void MGVCycle(mg_type *all_grids, int e_id, int R_id, double a, double b, int le
 
   // down...
   _LevelStart = getTime();
-       smooth(all_grids->levels[level  ],e_id,R_id,a,b);
-     residual(all_grids->levels[level  ],VECTOR_TEMP,e_id,R_id,a,b);
+  smooth_and_residual(all_grids->levels[level  ],e_id,R_id,VECTOR_TEMP,a,b);
   restriction(all_grids->levels[level+1],R_id,all_grids->levels[level],VECTOR_TEMP,RESTRICT_CELL);
   zero_vector(all_grids->levels[level+1],e_id);
   all_grids->levels[level]->timers.Total += (double)(getTime()-_LevelStart);
 
-  // recursion...
-  MGVCycle(all_grids,e_id,R_id,a,b,level+1);
+  // recursion (one or more cycles on level+1 per --cycle-index and --kcycle)...
+  MGCoarseCorrection(all_grids,e_id,R_id,a,b,level+1);
 
   // up...
   _LevelStart = getTime();
@@ -1096,6 +2042,7 @@ void MGVCycle(mg_type *all_grids, int e_id, int R_id, double a, double b, int le
 //------------------------------------------------------------------------------------------------------------------------------
 void MGSolve(mg_type *all_grids, int onLevel, int u_id, int F_id, double a, double b, double dtol, double rtol){
   // solves Au=f on level 'onLevel'
+  MGSetLowOrderLevels(all_grids,onLevel,a,b); // before the timers (rebuilds the operator of levels whose variant changes)
   all_grids->MGSolves_performed++;
   if(!all_grids->levels[onLevel]->active)return;
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -1173,6 +2120,7 @@ void MGSolve(mg_type *all_grids, int onLevel, int u_id, int F_id, double a, doub
 
 //------------------------------------------------------------------------------------------------------------------------------
 void FMGSolve(mg_type *all_grids, int onLevel, int u_id, int F_id, double a, double b, double dtol, double rtol){
+  MGSetLowOrderLevels(all_grids,onLevel,a,b); // before the timers (rebuilds the operator of levels whose variant changes)
   all_grids->MGSolves_performed++;
   if(!all_grids->levels[onLevel]->active)return;
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -1307,7 +2255,7 @@ void MGPCG(mg_type *all_grids, int onLevel, int x_id, int F_id, double a, double
   for(l=0;l<all_grids->num_levels;l++){
     if(all_grids->levels[l]->must_subtract_mean==-1){
       all_grids->levels[l]->must_subtract_mean=0;
-      int alpha_is_zero = (dot(all_grids->levels[l],VECTOR_ALPHA,VECTOR_ALPHA) == 0.0);
+      int alpha_is_zero = all_grids->levels[l]->constant_coefficients ? (all_grids->levels[l]->constant_alpha==0.0) : (dot(all_grids->levels[l],VECTOR_ALPHA,VECTOR_ALPHA) == 0.0);
       if( (all_grids->levels[l]->boundary_condition.type==BC_PERIODIC) && ((a==0) || (alpha_is_zero)) )all_grids->levels[l]->must_subtract_mean = 1;
     }
   }
@@ -15,18 +15,50 @@
 #ifndef MG_AGGLOMERATION_START
 #define MG_AGGLOMERATION_START  8 // i.e. start the distributed v-cycle when boxes are smaller than 8^3
 #endif
+#ifndef MAX_COARSE_DIM
+#define MAX_COARSE_DIM 11 // default for --max-coarse-dim (i.e. the coarsest grid is at most 11^3)
+#endif
 #ifndef MG_DEFAULT_BOTTOM_NORM
 #define MG_DEFAULT_BOTTOM_NORM  1e-3
 #endif
 //------------------------------------------------------------------------------------------------------------------------------
+#define MG_CYCLE_V 0 // v-cycles
+#define MG_CYCLE_F 1 // f-cycles (FMG)
+#define MG_CYCLE_U 2 // truncated v-cycles (no agglomeration)
+#define MG_MAX_LEVELS 100
+//------------------------------------------------------------------------------------------------------------------------------
+// runtime selection of the cycle, bottom solver, and (per-level) smoother
+typedef struct {
+  int cycle;				// MG_CYCLE_V, MG_CYCLE_F, or MG_CYCLE_U
+  int bottom_solver;			// BOTTOM_* (see solvers.h)
+  int num_smoothers;			// number of valid entries in smoothers[]... coarser levels use the last entry
+  int smoothers[MG_MAX_LEVELS];		// SMOOTHER_* (see operators.h) for level 0,1,2...
+  double smoother_target;		// if >0, MGBuild selects each level's smoother to reach this estimated V-cycle convergence factor
+  int max_coarse_dim;			// problem sizes are restricted to those whose coarsest grid is at most max_coarse_dim in each dimension
+  int constant_coefficients;		// 0=variable coefficients, 1=use the constant-coefficient operator (warns if alpha and beta's are not constant), -1=use it only if they are
+  int lanczos_iterations;		// if >0, MGBuild estimates the extreme eigenvalues of D^{-1}A on each level with this many Lanczos iterations
+  int num_chebyshev_steps;		// number of valid entries in chebyshev_steps[] (0 = communication-avoiding chebyshev was not requested)
+  int chebyshev_steps[MG_MAX_LEVELS];	// chebyshev steps per ghost zone exchange for level 0,1,2... coarser levels use the last entry
+  int num_cycle_indices;		// number of valid entries in cycle_index[] (0 = V-cycles)
+  int cycle_index[MG_MAX_LEVELS];	// coarse grid corrections (1=V, 2=W) per visit of level 0,1,2... coarser levels use the last entry
+  int kcycle;				// if set, levels with a cycle index of 2 accelerate their two coarse grid corrections with flexible CG (K-cycle)
+  int high_order_levels;		// if >0, only this many of the finest levels use the high-order operator.  Coarser levels use its 2nd order variant (0 = all levels)
+} mg_options_type;
+//------------------------------------------------------------------------------------------------------------------------------
 typedef struct {
   int num_ranks;	// total number of MPI ranks for MPI_COMM_WORLD
   int my_rank;		// my MPI rank for MPI_COMM_WORLD
   int       num_levels;	// depth of the v-cycle
   level_type ** levels;	// array of pointers to levels
+  mg_options_type options;
 
   struct {
     double MGBuild; // total time spent building the coefficients...
+    double MGBuild_levels;   // ... of which creating the coarse levels (decomposition, vectors, ghost zone and BC lists)
+    double MGBuild_lists;    // ... of which building the restriction and interpolation lists
+    double MGBuild_subcomm;  // ... of which building the MPI subcommunicators
+    double MGBuild_operator; // ... of which rebuilding the operator (restricting the coefficients, Dinv, lambda_max) on the coarse levels
+    double MGBuild_tune;     // ... of which tuning the smoothers and tiles
     double MGSolve; // total time spent in MGSolve
   }timers;
   int MGSolves_performed;
@@ -34,7 +66,12 @@ typedef struct {
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-void          MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int minCoarseGridDim);
+void          MGBuild(mg_type *all_grids, level_type *fine_grid, double a, double b, int minCoarseGridDim, mg_options_type *options);
+void MGDefaultOptions(mg_options_type *options);
+int    MGParseOptions(mg_options_type *options, int *argc, char **argv);
+void   MGPrintOptions(mg_options_type *options);
+int    MGChebyshevSteps(mg_options_type *options, int level);
+int    MGCycleIndex(mg_options_type *options, int level);
 void          MGSolve(mg_type *all_grids, int onLevel, int u_id, int F_id, double a, double b, double dtol, double rtol);
 void         FMGSolve(mg_type *all_grids, int onLevel, int u_id, int F_id, double a, double b, double dtol, double rtol);
 void            MGPCG(mg_type *all_grids, int onLevel, int x_id, int F_id, double a, double b, double dtol, double rtol);
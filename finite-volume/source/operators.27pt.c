@@ -56,6 +56,10 @@ void apply_BCs(level_type * level, int x_id, int shape){apply_BCs_p2(level,x_id,
 #ifdef STENCIL_FUSE_BC
   #error This implementation does not support fusion of the boundary conditions with the operator
 #endif
+#ifdef USE_PACKED_COEFFICIENTS
+  #warning This implementation does not interleave its coefficients.  Ignoring -DUSE_PACKED_COEFFICIENTS
+  #undef USE_PACKED_COEFFICIENTS
+#endif
 //------------------------------------------------------------------------------------------------------------------------------
 #define Dinv_ijk() Dinv[ijk]        // simply retrieve it rather than recalculating it
 //------------------------------------------------------------------------------------------------------------------------------
@@ -92,8 +96,17 @@ void apply_BCs(level_type * level, int x_id, int shape){apply_BCs_p2(level,x_id,
   )						\
 )
 //------------------------------------------------------------------------------------------------------------------------------
+// k-line coefficients (see operators/zline.c)... tridiagonal
+#define STENCIL_LINE_COEFFICIENTS
+#define Akm2_ijk() 0.0
+#define Akm1_ijk() ( -b*h2inv*STENCIL_COEF1 )
+#define Akp1_ijk() ( -b*h2inv*STENCIL_COEF1 )
+#define Akp2_ijk() 0.0
+//------------------------------------------------------------------------------------------------------------------------------
 int stencil_get_radius(){return(1);} // 27pt = dense 3^3
 int stencil_get_shape(){return(STENCIL_SHAPE_BOX);} // needs faces, edges, and corners
+int stencil_supports_constant_coefficients(){return(0);} // no coefficient-free path
+int stencil_supports_low_order(){return(0);} // already (at most) 2nd order
 //------------------------------------------------------------------------------------------------------------------------------
 void rebuild_operator(level_type * level, level_type *fromLevel, double a, double b){
   // form restriction of alpha[], beta_*[] coefficients from fromLevel
@@ -122,33 +135,26 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
 //------------------------------------------------------------------------------------------------------------------------------
 #ifdef  USE_GSRB
 #warning GSRB is not recommended for the 27pt operator
-#define GSRB_OOP
-#define NUM_SMOOTHS      2 // RBRB
-#include "operators/gsrb.c"
-#elif   USE_CHEBY
-#define NUM_SMOOTHS      1
-#define CHEBYSHEV_DEGREE 4 // i.e. one degree-4 polynomial smoother
-#include "operators/chebyshev.c"
-#elif   USE_JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_L1JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_SYMGS
-#define NUM_SMOOTHS      2 // FBFB
-#include "operators/symgs.c"
-#else
-#error You must compile with either -DUSE_GSRB, -DUSE_CHEBY, -DUSE_JACOBI, -DUSE_L1JACOBI, or -DUSE_SYMGS
 #endif
+#define GSRB_OOP
+#define GSRB_NUM_SMOOTHS      2 // RBRB
+#define CHEBYSHEV_NUM_SMOOTHS 1
+#define CHEBYSHEV_DEGREE      4 // i.e. one degree-4 polynomial smoother
+#define JACOBI_NUM_SMOOTHS    6
+#define SYMGS_NUM_SMOOTHS     2 // FBFB
+#define ZLINE_NUM_SMOOTHS     1 // FB
+#include "operators/smoothers.c"
 #include "operators/residual.c"
 #include "operators/apply_op.c"
 #include "operators/rebuild.c"
 //------------------------------------------------------------------------------------------------------------------------------
 #include "operators/blockCopy.c"
+#include "operators/unpack.c"
+#include "operators/comm_thread.c"
 #include "operators/misc.c"
 #include "operators/exchange_boundary.c"
 #include "operators/boundary_fd.c" // 27pt uses cell centered, not cell averaged
+#include "operators/tasks.c"
 //#include "operators/boundary_fv.c"
 #include "operators/restriction.c"
 #include "operators/interpolation_p2.c"
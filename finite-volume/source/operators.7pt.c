@@ -44,6 +44,10 @@
   #define PRAGMA_THREAD_ACROSS_BLOCKS_SUM(level,b,nb,bsum)    
   #define PRAGMA_THREAD_ACROSS_BLOCKS_MAX(level,b,nb,bmax)    
 #endif
+#ifdef USE_PACKED_COEFFICIENTS
+  #warning This implementation does not interleave its coefficients.  Ignoring -DUSE_PACKED_COEFFICIENTS
+  #undef USE_PACKED_COEFFICIENTS
+#endif
 //------------------------------------------------------------------------------------------------------------------------------
 void apply_BCs(level_type * level, int x_id, int shape){
   #ifndef STENCIL_FUSE_BC
@@ -52,30 +56,35 @@ void apply_BCs(level_type * level, int x_id, int shape){
   #endif
 }
 //------------------------------------------------------------------------------------------------------------------------------
+// 1.0 if the neighboring cell is inside the domain (i.e. was a VECTOR_VALID mask).  valid is the box's valid_region_type
+#define valid_i(di) ( ( (i+(di)>=valid.lo.i) && (i+(di)<valid.hi.i) ) ? 1.0 : 0.0 )
+#define valid_j(dj) ( ( (j+(dj)>=valid.lo.j) && (j+(dj)<valid.hi.j) ) ? 1.0 : 0.0 )
+#define valid_k(dk) ( ( (k+(dk)>=valid.lo.k) && (k+(dk)<valid.hi.k) ) ? 1.0 : 0.0 )
+//------------------------------------------------------------------------------------------------------------------------------
 // calculate Dinv?
 #ifdef STENCIL_VARIABLE_COEFFICIENT
   #ifdef USE_HELMHOLTZ // variable coefficient Helmholtz ...
   #define calculate_Dinv()                                      \
   (                                                             \
     1.0 / (a*alpha[ijk] - b*h2inv*(                             \
-             + beta_i[ijk        ]*( valid[ijk-1      ] - 2.0 ) \
-             + beta_j[ijk        ]*( valid[ijk-jStride] - 2.0 ) \
-             + beta_k[ijk        ]*( valid[ijk-kStride] - 2.0 ) \
-             + beta_i[ijk+1      ]*( valid[ijk+1      ] - 2.0 ) \
-             + beta_j[ijk+jStride]*( valid[ijk+jStride] - 2.0 ) \
-             + beta_k[ijk+kStride]*( valid[ijk+kStride] - 2.0 ) \
+             + beta_i[ijk        ]*( valid_i(-1) - 2.0 )        \
+             + beta_j[ijk        ]*( valid_j(-1) - 2.0 )        \
+             + beta_k[ijk        ]*( valid_k(-1) - 2.0 )        \
+             + beta_i[ijk+1      ]*( valid_i(+1) - 2.0 )        \
+             + beta_j[ijk+jStride]*( valid_j(+1) - 2.0 )        \
+             + beta_k[ijk+kStride]*( valid_k(+1) - 2.0 )        \
           ))                                                    \
   )
   #else // variable coefficient Poisson ...
   #define calculate_Dinv()                                      \
   (                                                             \
     1.0 / ( -b*h2inv*(                                          \
-             + beta_i[ijk        ]*( valid[ijk-1      ] - 2.0 ) \
-             + beta_j[ijk        ]*( valid[ijk-jStride] - 2.0 ) \
-             + beta_k[ijk        ]*( valid[ijk-kStride] - 2.0 ) \
-             + beta_i[ijk+1      ]*( valid[ijk+1      ] - 2.0 ) \
-             + beta_j[ijk+jStride]*( valid[ijk+jStride] - 2.0 ) \
-             + beta_k[ijk+kStride]*( valid[ijk+kStride] - 2.0 ) \
+             + beta_i[ijk        ]*( valid_i(-1) - 2.0 )        \
+             + beta_j[ijk        ]*( valid_j(-1) - 2.0 )        \
+             + beta_k[ijk        ]*( valid_k(-1) - 2.0 )        \
+             + beta_i[ijk+1      ]*( valid_i(+1) - 2.0 )        \
+             + beta_j[ijk+jStride]*( valid_j(+1) - 2.0 )        \
+             + beta_k[ijk+kStride]*( valid_k(+1) - 2.0 )        \
           ))                                                    \
   )
   #endif
@@ -83,12 +92,12 @@ void apply_BCs(level_type * level, int x_id, int shape){
   #define calculate_Dinv()          \
   (                                 \
     1.0 / (a - b*h2inv*(            \
-             + valid[ijk-1      ]   \
-             + valid[ijk-jStride]   \
-             + valid[ijk-kStride]   \
-             + valid[ijk+1      ]   \
-             + valid[ijk+jStride]   \
-             + valid[ijk+kStride]   \
+             + valid_i(-1)          \
+             + valid_j(-1)          \
+             + valid_k(-1)          \
+             + valid_i(+1)          \
+             + valid_j(+1)          \
+             + valid_k(+1)          \
              - 12.0                 \
           ))                        \
   )
@@ -108,24 +117,24 @@ void apply_BCs(level_type * level, int x_id, int shape){
     (                                                                                         \
       a*alpha[ijk]*x[ijk]                                                                     \
       -b*h2inv*(                                                                              \
-        + beta_i[ijk        ]*( valid[ijk-1      ]*( x[ijk] + x[ijk-1      ] ) - 2.0*x[ijk] ) \
-        + beta_j[ijk        ]*( valid[ijk-jStride]*( x[ijk] + x[ijk-jStride] ) - 2.0*x[ijk] ) \
-        + beta_k[ijk        ]*( valid[ijk-kStride]*( x[ijk] + x[ijk-kStride] ) - 2.0*x[ijk] ) \
-        + beta_i[ijk+1      ]*( valid[ijk+1      ]*( x[ijk] + x[ijk+1      ] ) - 2.0*x[ijk] ) \
-        + beta_j[ijk+jStride]*( valid[ijk+jStride]*( x[ijk] + x[ijk+jStride] ) - 2.0*x[ijk] ) \
-        + beta_k[ijk+kStride]*( valid[ijk+kStride]*( x[ijk] + x[ijk+kStride] ) - 2.0*x[ijk] ) \
+        + beta_i[ijk        ]*( valid_i(-1)*( x[ijk] + x[ijk-1      ] ) - 2.0*x[ijk] )        \
+        + beta_j[ijk        ]*( valid_j(-1)*( x[ijk] + x[ijk-jStride] ) - 2.0*x[ijk] )        \
+        + beta_k[ijk        ]*( valid_k(-1)*( x[ijk] + x[ijk-kStride] ) - 2.0*x[ijk] )        \
+        + beta_i[ijk+1      ]*( valid_i(+1)*( x[ijk] + x[ijk+1      ] ) - 2.0*x[ijk] )        \
+        + beta_j[ijk+jStride]*( valid_j(+1)*( x[ijk] + x[ijk+jStride] ) - 2.0*x[ijk] )        \
+        + beta_k[ijk+kStride]*( valid_k(+1)*( x[ijk] + x[ijk+kStride] ) - 2.0*x[ijk] )        \
       )                                                                                       \
     )
     #else // variable coefficient Poisson ...
     #define apply_op_ijk(x)                                                                   \
     (                                                                                         \
       -b*h2inv*(                                                                              \
-        + beta_i[ijk        ]*( valid[ijk-1      ]*( x[ijk] + x[ijk-1      ] ) - 2.0*x[ijk] ) \
-        + beta_j[ijk        ]*( valid[ijk-jStride]*( x[ijk] + x[ijk-jStride] ) - 2.0*x[ijk] ) \
-        + beta_k[ijk        ]*( valid[ijk-kStride]*( x[ijk] + x[ijk-kStride] ) - 2.0*x[ijk] ) \
-        + beta_i[ijk+1      ]*( valid[ijk+1      ]*( x[ijk] + x[ijk+1      ] ) - 2.0*x[ijk] ) \
-        + beta_j[ijk+jStride]*( valid[ijk+jStride]*( x[ijk] + x[ijk+jStride] ) - 2.0*x[ijk] ) \
-        + beta_k[ijk+kStride]*( valid[ijk+kStride]*( x[ijk] + x[ijk+kStride] ) - 2.0*x[ijk] ) \
+        + beta_i[ijk        ]*( valid_i(-1)*( x[ijk] + x[ijk-1      ] ) - 2.0*x[ijk] )        \
+        + beta_j[ijk        ]*( valid_j(-1)*( x[ijk] + x[ijk-jStride] ) - 2.0*x[ijk] )        \
+        + beta_k[ijk        ]*( valid_k(-1)*( x[ijk] + x[ijk-kStride] ) - 2.0*x[ijk] )        \
+        + beta_i[ijk+1      ]*( valid_i(+1)*( x[ijk] + x[ijk+1      ] ) - 2.0*x[ijk] )        \
+        + beta_j[ijk+jStride]*( valid_j(+1)*( x[ijk] + x[ijk+jStride] ) - 2.0*x[ijk] )        \
+        + beta_k[ijk+kStride]*( valid_k(+1)*( x[ijk] + x[ijk+kStride] ) - 2.0*x[ijk] )        \
       )                                                                                       \
     )
     #endif
@@ -133,12 +142,12 @@ void apply_BCs(level_type * level, int x_id, int shape){
     #define apply_op_ijk(x)                                \
     (                                                    \
       a*x[ijk] - b*h2inv*(                               \
-        + valid[ijk-1      ]*( x[ijk] + x[ijk-1      ] ) \
-        + valid[ijk-jStride]*( x[ijk] + x[ijk-jStride] ) \
-        + valid[ijk-kStride]*( x[ijk] + x[ijk-kStride] ) \
-        + valid[ijk+1      ]*( x[ijk] + x[ijk+1      ] ) \
-        + valid[ijk+jStride]*( x[ijk] + x[ijk+jStride] ) \
-        + valid[ijk+kStride]*( x[ijk] + x[ijk+kStride] ) \
+        + valid_i(-1)*( x[ijk] + x[ijk-1      ] )        \
+        + valid_j(-1)*( x[ijk] + x[ijk-jStride] )        \
+        + valid_k(-1)*( x[ijk] + x[ijk-kStride] )        \
+        + valid_i(+1)*( x[ijk] + x[ijk+1      ] )        \
+        + valid_j(+1)*( x[ijk] + x[ijk+jStride] )        \
+        + valid_k(+1)*( x[ijk] + x[ijk+kStride] )        \
                        -12.0*( x[ijk]                  ) \
       )                                                  \
     )
@@ -195,9 +204,23 @@ void apply_BCs(level_type * level, int x_id, int shape){
 #endif // BCs
 
 
+//------------------------------------------------------------------------------------------------------------------------------
+// k-line coefficients (see operators/zline.c)... tridiagonal
+#define STENCIL_LINE_COEFFICIENTS
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #define Akm1_ijk() ( -b*h2inv*beta_k[ijk        ] )
+  #define Akp1_ijk() ( -b*h2inv*beta_k[ijk+kStride] )
+#else
+  #define Akm1_ijk() ( -b*h2inv )
+  #define Akp1_ijk() ( -b*h2inv )
+#endif
+#define Akm2_ijk() 0.0
+#define Akp2_ijk() 0.0
 //------------------------------------------------------------------------------------------------------------------------------
 int stencil_get_radius(){return(1);} // 7pt reaches out 1 point
 int stencil_get_shape(){return(STENCIL_SHAPE_STAR);} // needs just faces
+int stencil_supports_constant_coefficients(){return(0);} // no coefficient-free path
+int stencil_supports_low_order(){return(0);} // already (at most) 2nd order
 //------------------------------------------------------------------------------------------------------------------------------
 void rebuild_operator(level_type * level, level_type *fromLevel, double a, double b){
   if(level->my_rank==0){fprintf(stdout,"  rebuilding operator for level...  h=%e  ",level->h);fflush(stdout);}
@@ -215,9 +238,9 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // exchange alpha/beta/...  (must be done before calculating Dinv)
   exchange_boundary(level,VECTOR_ALPHA ,STENCIL_SHAPE_BOX); // safe
-  exchange_boundary(level,VECTOR_BETA_I,STENCIL_SHAPE_BOX);
-  exchange_boundary(level,VECTOR_BETA_J,STENCIL_SHAPE_BOX);
-  exchange_boundary(level,VECTOR_BETA_K,STENCIL_SHAPE_BOX);
+  exchange_boundary_faces(level,VECTOR_BETA_I,0);
+  exchange_boundary_faces(level,VECTOR_BETA_J,1);
+  exchange_boundary_faces(level,VECTOR_BETA_K,2);
 
   // make sure that the GPU kernels are completed as the following part will run on CPU
   cudaDeviceSynchronize();
@@ -249,7 +272,7 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
     double * __restrict__ beta_k = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
     double * __restrict__   Dinv = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
     double * __restrict__  L1inv = level->my_boxes[box].vectors[VECTOR_L1INV ] + ghosts*(1+jStride+kStride);
-    double * __restrict__  valid = level->my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride);
+    valid_region_type      valid = level->my_boxes[box].valid; // cells (box-relative) inside the domain
     double block_eigenvalue = -1e9;
 
     for(k=klo;k<khi;k++){
@@ -260,42 +283,42 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
       #ifdef STENCIL_VARIABLE_COEFFICIENT
       // radius of Gershgorin disc is the sum of the absolute values of the off-diagonal elements...
       double sumAbsAij = fabs(b*h2inv) * (
-                           fabs( beta_i[ijk        ]*valid[ijk-1      ] )+
-                           fabs( beta_j[ijk        ]*valid[ijk-jStride] )+
-                           fabs( beta_k[ijk        ]*valid[ijk-kStride] )+
-                           fabs( beta_i[ijk+1      ]*valid[ijk+1      ] )+
-                           fabs( beta_j[ijk+jStride]*valid[ijk+jStride] )+
-                           fabs( beta_k[ijk+kStride]*valid[ijk+kStride] )
+                           fabs( beta_i[ijk        ]*valid_i(-1) )+
+                           fabs( beta_j[ijk        ]*valid_j(-1) )+
+                           fabs( beta_k[ijk        ]*valid_k(-1) )+
+                           fabs( beta_i[ijk+1      ]*valid_i(+1) )+
+                           fabs( beta_j[ijk+jStride]*valid_j(+1) )+
+                           fabs( beta_k[ijk+kStride]*valid_k(+1) )
                          );
 
       // center of Gershgorin disc is the diagonal element...
       double    Aii = a*alpha[ijk] - b*h2inv*(
-                        beta_i[ijk        ]*( valid[ijk-1      ]-2.0 )+
-                        beta_j[ijk        ]*( valid[ijk-jStride]-2.0 )+
-                        beta_k[ijk        ]*( valid[ijk-kStride]-2.0 )+
-                        beta_i[ijk+1      ]*( valid[ijk+1      ]-2.0 )+
-                        beta_j[ijk+jStride]*( valid[ijk+jStride]-2.0 )+
-                        beta_k[ijk+kStride]*( valid[ijk+kStride]-2.0 ) 
+                        beta_i[ijk        ]*( valid_i(-1)-2.0 )+
+                        beta_j[ijk        ]*( valid_j(-1)-2.0 )+
+                        beta_k[ijk        ]*( valid_k(-1)-2.0 )+
+                        beta_i[ijk+1      ]*( valid_i(+1)-2.0 )+
+                        beta_j[ijk+jStride]*( valid_j(+1)-2.0 )+
+                        beta_k[ijk+kStride]*( valid_k(+1)-2.0 ) 
                       );
       #else // Constant coefficient versions with fused BC's...
       // radius of Gershgorin disc is the sum of the absolute values of the off-diagonal elements...
       double sumAbsAij = fabs(b*h2inv) * (
-                           valid[ijk-1      ] +
-                           valid[ijk-jStride] +
-                           valid[ijk-kStride] +
-                           valid[ijk+1      ] +
-                           valid[ijk+jStride] +
-                           valid[ijk+kStride] 
+                           valid_i(-1) +
+                           valid_j(-1) +
+                           valid_k(-1) +
+                           valid_i(+1) +
+                           valid_j(+1) +
+                           valid_k(+1) 
                          );
 
       // center of Gershgorin disc is the diagonal element...
       double    Aii = a - b*h2inv*(
-                         valid[ijk-1      ] +
-                         valid[ijk-jStride] +
-                         valid[ijk-kStride] +
-                         valid[ijk+1      ] +
-                         valid[ijk+jStride] +
-                         valid[ijk+kStride] - 12.0
+                         valid_i(-1) +
+                         valid_j(-1) +
+                         valid_k(-1) +
+                         valid_i(+1) +
+                         valid_j(+1) +
+                         valid_k(+1) - 12.0
                       );
       #endif
 
@@ -335,32 +358,22 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-#ifdef  USE_GSRB
-#define NUM_SMOOTHS      2 // RBRB
-#include "operators/gsrb.c"
-#elif   USE_CHEBY
-#define NUM_SMOOTHS      1
-#define CHEBYSHEV_DEGREE 4 // i.e. one degree-4 polynomial smoother
-#include "operators/chebyshev.c"
-#elif   USE_JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_L1JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_SYMGS
-#define NUM_SMOOTHS      2
-#include "operators/symgs.c"
-#else
-#error You must compile with either -DUSE_GSRB, -DUSE_CHEBY, -DUSE_JACOBI, -DUSE_L1JACOBI, or -DUSE_SYMGS
-#endif
+#define GSRB_NUM_SMOOTHS      2 // RBRB
+#define CHEBYSHEV_NUM_SMOOTHS 1
+#define CHEBYSHEV_DEGREE      4 // i.e. one degree-4 polynomial smoother
+#define JACOBI_NUM_SMOOTHS    6
+#define SYMGS_NUM_SMOOTHS     2
+#include "operators/smoothers.c"
 #include "operators/residual.c"
 #include "operators/apply_op.c"
 //------------------------------------------------------------------------------------------------------------------------------
 #include "operators/blockCopy.c"
+#include "operators/unpack.c"
+#include "operators/comm_thread.c"
 #include "operators/misc.c"
 #include "operators/exchange_boundary.c"
 #include "operators/boundary_fd.c"
+#include "operators/tasks.c"
 #include "operators/restriction.c"
 #include "operators/interpolation_p0.c"
 #include "operators/interpolation_p1.c"
@@ -48,6 +48,10 @@
 #ifdef STENCIL_FUSE_BC
   #error This implementation does not support fusion of the boundary conditions with the operator
 #endif
+#ifdef USE_PACKED_COEFFICIENTS
+  #warning This implementation does not interleave its coefficients.  Ignoring -DUSE_PACKED_COEFFICIENTS
+  #undef USE_PACKED_COEFFICIENTS
+#endif
 //------------------------------------------------------------------------------------------------------------------------------
 void apply_BCs(level_type * level, int x_id, int shape){apply_BCs_v2(level,x_id,shape);}
 //------------------------------------------------------------------------------------------------------------------------------
@@ -95,8 +99,36 @@ void apply_BCs(level_type * level, int x_id, int shape){apply_BCs_v2(level,x_id,
   )
 #endif // variable/constant coefficient
 //------------------------------------------------------------------------------------------------------------------------------
+// Analytic rows (see rebuild_operator_blackbox())... with 2 colors, the neighbors on either side share a color
+#define STENCIL_ANALYTIC_COLORS 2
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #ifdef USE_HELMHOLTZ
+  #define Aii_ijk() ( a*alpha[ijk] + b*h2inv*( beta_i[ijk]+beta_i[ijk+1]+beta_j[ijk]+beta_j[ijk+jStride]+beta_k[ijk]+beta_k[ijk+kStride] ) )
+  #else
+  #define Aii_ijk() (                b*h2inv*( beta_i[ijk]+beta_i[ijk+1]+beta_j[ijk]+beta_j[ijk+jStride]+beta_k[ijk]+beta_k[ijk+kStride] ) )
+  #endif
+  #define sumAbsAij_ijk() ( fabs(b*h2inv)*( fabs(beta_i[ijk]+beta_i[ijk+1]) + fabs(beta_j[ijk]+beta_j[ijk+jStride]) + fabs(beta_k[ijk]+beta_k[ijk+kStride]) ) )
+#else
+  #define       Aii_ijk() ( a + b*h2inv*6.0 )
+  #define sumAbsAij_ijk() ( fabs(b*h2inv)*6.0 )
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
+// k-line coefficients (see operators/zline.c)... tridiagonal
+#define STENCIL_LINE_COEFFICIENTS
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #define Akm1_ijk() ( -b*h2inv*beta_k[ijk        ] )
+  #define Akp1_ijk() ( -b*h2inv*beta_k[ijk+kStride] )
+#else
+  #define Akm1_ijk() ( -b*h2inv )
+  #define Akp1_ijk() ( -b*h2inv )
+#endif
+#define Akm2_ijk() 0.0
+#define Akp2_ijk() 0.0
+//------------------------------------------------------------------------------------------------------------------------------
 int stencil_get_radius(){return(1);}
 int stencil_get_shape(){return(STENCIL_SHAPE_STAR);} // needs just faces
+int stencil_supports_constant_coefficients(){return(0);} // no coefficient-free path
+int stencil_supports_low_order(){return(0);} // already (at most) 2nd order
 //------------------------------------------------------------------------------------------------------------------------------
 void rebuild_operator(level_type * level, level_type *fromLevel, double a, double b){
   // form restriction of alpha[], beta_*[] coefficients from fromLevel
@@ -113,9 +145,9 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
 
   // exchange alpha/beta/...  (must be done before calculating Dinv)
   exchange_boundary(level,VECTOR_ALPHA ,STENCIL_SHAPE_BOX); // safe
-  exchange_boundary(level,VECTOR_BETA_I,STENCIL_SHAPE_BOX);
-  exchange_boundary(level,VECTOR_BETA_J,STENCIL_SHAPE_BOX);
-  exchange_boundary(level,VECTOR_BETA_K,STENCIL_SHAPE_BOX);
+  exchange_boundary_faces(level,VECTOR_BETA_I,0);
+  exchange_boundary_faces(level,VECTOR_BETA_J,1);
+  exchange_boundary_faces(level,VECTOR_BETA_K,2);
 
   // black box rebuild of D^{-1}, l1^{-1}, dominant eigenvalue, ...
   rebuild_operator_blackbox(level,a,b,2);
@@ -127,34 +159,25 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-#ifdef  USE_GSRB
 //#define GSRB_OOP	// no need for out-of-place for 7pt
-#define NUM_SMOOTHS      3 // RBRBRB
-#include "operators/gsrb.c"
-#elif   USE_CHEBY
-#define NUM_SMOOTHS      1
-#define CHEBYSHEV_DEGREE 6 // i.e. one degree-6 polynomial smoother
-#include "operators/chebyshev.c"
-#elif   USE_JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_L1JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_SYMGS
-#define NUM_SMOOTHS      2 // FBFB
-#include "operators/symgs.c"
-#else
-#error You must compile with either -DUSE_GSRB, -DUSE_CHEBY, -DUSE_JACOBI, -DUSE_L1JACOBI, or -DUSE_SYMGS
-#endif
+#define GSRB_NUM_SMOOTHS      3 // RBRBRB
+#define CHEBYSHEV_NUM_SMOOTHS 1
+#define CHEBYSHEV_DEGREE      6 // i.e. one degree-6 polynomial smoother
+#define JACOBI_NUM_SMOOTHS    6
+#define SYMGS_NUM_SMOOTHS     2 // FBFB
+#define ZLINE_NUM_SMOOTHS     1 // FB
+#include "operators/smoothers.c"
 #include "operators/residual.c"
 #include "operators/apply_op.c"
 #include "operators/rebuild.c"
 //------------------------------------------------------------------------------------------------------------------------------
 #include "operators/blockCopy.c"
+#include "operators/unpack.c"
+#include "operators/comm_thread.c"
 #include "operators/misc.c"
 #include "operators/exchange_boundary.c"
 #include "operators/boundary_fv.c"
+#include "operators/tasks.c"
 #include "operators/restriction.c"
 #include "operators/interpolation_v2.c"
 //------------------------------------------------------------------------------------------------------------------------------
@@ -49,93 +49,249 @@
   #error This implementation does not support fusion of the boundary conditions with the operator
 #endif
 //------------------------------------------------------------------------------------------------------------------------------
-void apply_BCs(level_type * level, int x_id, int shape){apply_BCs_v4(level,x_id,shape);}
+void apply_BCs(level_type * level, int x_id, int shape){if(level->low_order)apply_BCs_v2(level,x_id,shape);else apply_BCs_v4(level,x_id,shape);}
 //------------------------------------------------------------------------------------------------------------------------------
+#ifdef USE_PACKED_COEFFICIENTS // alpha, beta's, Dinv, and L1inv of each cell are interleaved (see operators/packed.c)
+#define  ALPHA(o) coefs[PACKED_COEFS*(ijk+(o))+PACKED_ALPHA ]
+#define BETA_I(o) coefs[PACKED_COEFS*(ijk+(o))+PACKED_BETA_I]
+#define BETA_J(o) coefs[PACKED_COEFS*(ijk+(o))+PACKED_BETA_J]
+#define BETA_K(o) coefs[PACKED_COEFS*(ijk+(o))+PACKED_BETA_K]
+#define Dinv_ijk() ( level->constant_coefficients ? Dinv[ijk] : coefs[PACKED_COEFS*ijk+PACKED_DINV] ) // constant-coefficient levels are not packed
+#else
+#define  ALPHA(o)  alpha[ijk+(o)]
+#define BETA_I(o) beta_i[ijk+(o)]
+#define BETA_J(o) beta_j[ijk+(o)]
+#define BETA_K(o) beta_k[ijk+(o)]
 #define Dinv_ijk() Dinv[ijk]        // simply retrieve it rather than recalculating it
+#endif
 //------------------------------------------------------------------------------------------------------------------------------
 #define STENCIL_TWELFTH ( 0.0833333333333333333)  // 1.0/12.0;
 //------------------------------------------------------------------------------------------------------------------------------
 #ifdef STENCIL_VARIABLE_COEFFICIENT
   #ifdef USE_HELMHOLTZ
-  #define apply_op_ijk(x)                                                                                                                            \
+  #define apply_op_variable_ijk(x)                                                                                                                   \
   (                                                                                                                                                  \
-    a*alpha[ijk]*x[ijk]                                                                                                                              \
+    a*ALPHA(0)*x[ijk]                                                                                                                                \
    -b*h2inv*(                                                                                                                                        \
       STENCIL_TWELFTH*(                                                                                                                              \
-        + beta_i[ijk        ]*( 15.0*(x[ijk-1      ]-x[ijk]) - (x[ijk-2        ]-x[ijk+1      ]) )                                                   \
-        + beta_i[ijk+1      ]*( 15.0*(x[ijk+1      ]-x[ijk]) - (x[ijk+2        ]-x[ijk-1      ]) )                                                   \
-        + beta_j[ijk        ]*( 15.0*(x[ijk-jStride]-x[ijk]) - (x[ijk-2*jStride]-x[ijk+jStride]) )                                                   \
-        + beta_j[ijk+jStride]*( 15.0*(x[ijk+jStride]-x[ijk]) - (x[ijk+2*jStride]-x[ijk-jStride]) )                                                   \
-        + beta_k[ijk        ]*( 15.0*(x[ijk-kStride]-x[ijk]) - (x[ijk-2*kStride]-x[ijk+kStride]) )                                                   \
-        + beta_k[ijk+kStride]*( 15.0*(x[ijk+kStride]-x[ijk]) - (x[ijk+2*kStride]-x[ijk-kStride]) )                                                   \
+        + BETA_I(       0)   *( 15.0*(x[ijk-1      ]-x[ijk]) - (x[ijk-2        ]-x[ijk+1      ]) )                                                   \
+        + BETA_I(+1      )   *( 15.0*(x[ijk+1      ]-x[ijk]) - (x[ijk+2        ]-x[ijk-1      ]) )                                                   \
+        + BETA_J(       0)   *( 15.0*(x[ijk-jStride]-x[ijk]) - (x[ijk-2*jStride]-x[ijk+jStride]) )                                                   \
+        + BETA_J(+jStride)   *( 15.0*(x[ijk+jStride]-x[ijk]) - (x[ijk+2*jStride]-x[ijk-jStride]) )                                                   \
+        + BETA_K(       0)   *( 15.0*(x[ijk-kStride]-x[ijk]) - (x[ijk-2*kStride]-x[ijk+kStride]) )                                                   \
+        + BETA_K(+kStride)   *( 15.0*(x[ijk+kStride]-x[ijk]) - (x[ijk+2*kStride]-x[ijk-kStride]) )                                                   \
       )                                                                                                                                              \
       + 0.25*STENCIL_TWELFTH*(                                                                                                                       \
-        + (beta_i[ijk        +jStride]-beta_i[ijk        -jStride]) * (x[ijk-1      +jStride]-x[ijk+jStride]-x[ijk-1      -jStride]+x[ijk-jStride])  \
-        + (beta_i[ijk        +kStride]-beta_i[ijk        -kStride]) * (x[ijk-1      +kStride]-x[ijk+kStride]-x[ijk-1      -kStride]+x[ijk-kStride])  \
-        + (beta_j[ijk        +1      ]-beta_j[ijk        -1      ]) * (x[ijk-jStride+1      ]-x[ijk+1      ]-x[ijk-jStride-1      ]+x[ijk-1      ])  \
-        + (beta_j[ijk        +kStride]-beta_j[ijk        -kStride]) * (x[ijk-jStride+kStride]-x[ijk+kStride]-x[ijk-jStride-kStride]+x[ijk-kStride])  \
-        + (beta_k[ijk        +1      ]-beta_k[ijk        -1      ]) * (x[ijk-kStride+1      ]-x[ijk+1      ]-x[ijk-kStride-1      ]+x[ijk-1      ])  \
-        + (beta_k[ijk        +jStride]-beta_k[ijk        -jStride]) * (x[ijk-kStride+jStride]-x[ijk+jStride]-x[ijk-kStride-jStride]+x[ijk-jStride])  \
+        + (BETA_I(        +jStride)   -BETA_I(        -jStride)   ) * (x[ijk-1      +jStride]-x[ijk+jStride]-x[ijk-1      -jStride]+x[ijk-jStride])  \
+        + (BETA_I(        +kStride)   -BETA_I(        -kStride)   ) * (x[ijk-1      +kStride]-x[ijk+kStride]-x[ijk-1      -kStride]+x[ijk-kStride])  \
+        + (BETA_J(        +1      )   -BETA_J(        -1      )   ) * (x[ijk-jStride+1      ]-x[ijk+1      ]-x[ijk-jStride-1      ]+x[ijk-1      ])  \
+        + (BETA_J(        +kStride)   -BETA_J(        -kStride)   ) * (x[ijk-jStride+kStride]-x[ijk+kStride]-x[ijk-jStride-kStride]+x[ijk-kStride])  \
+        + (BETA_K(        +1      )   -BETA_K(        -1      )   ) * (x[ijk-kStride+1      ]-x[ijk+1      ]-x[ijk-kStride-1      ]+x[ijk-1      ])  \
+        + (BETA_K(        +jStride)   -BETA_K(        -jStride)   ) * (x[ijk-kStride+jStride]-x[ijk+jStride]-x[ijk-kStride-jStride]+x[ijk-jStride])  \
                                                                                                                                                      \
-        + (beta_i[ijk+1      +jStride]-beta_i[ijk+1      -jStride]) * (x[ijk+1      +jStride]-x[ijk+jStride]-x[ijk+1      -jStride]+x[ijk-jStride])  \
-        + (beta_i[ijk+1      +kStride]-beta_i[ijk+1      -kStride]) * (x[ijk+1      +kStride]-x[ijk+kStride]-x[ijk+1      -kStride]+x[ijk-kStride])  \
-        + (beta_j[ijk+jStride+1      ]-beta_j[ijk+jStride-1      ]) * (x[ijk+jStride+1      ]-x[ijk+1      ]-x[ijk+jStride-1      ]+x[ijk-1      ])  \
-        + (beta_j[ijk+jStride+kStride]-beta_j[ijk+jStride-kStride]) * (x[ijk+jStride+kStride]-x[ijk+kStride]-x[ijk+jStride-kStride]+x[ijk-kStride])  \
-        + (beta_k[ijk+kStride+1      ]-beta_k[ijk+kStride-1      ]) * (x[ijk+kStride+1      ]-x[ijk+1      ]-x[ijk+kStride-1      ]+x[ijk-1      ])  \
-        + (beta_k[ijk+kStride+jStride]-beta_k[ijk+kStride-jStride]) * (x[ijk+kStride+jStride]-x[ijk+jStride]-x[ijk+kStride-jStride]+x[ijk-jStride])  \
+        + (BETA_I(+1      +jStride)   -BETA_I(+1      -jStride)   ) * (x[ijk+1      +jStride]-x[ijk+jStride]-x[ijk+1      -jStride]+x[ijk-jStride])  \
+        + (BETA_I(+1      +kStride)   -BETA_I(+1      -kStride)   ) * (x[ijk+1      +kStride]-x[ijk+kStride]-x[ijk+1      -kStride]+x[ijk-kStride])  \
+        + (BETA_J(+jStride+1      )   -BETA_J(+jStride-1      )   ) * (x[ijk+jStride+1      ]-x[ijk+1      ]-x[ijk+jStride-1      ]+x[ijk-1      ])  \
+        + (BETA_J(+jStride+kStride)   -BETA_J(+jStride-kStride)   ) * (x[ijk+jStride+kStride]-x[ijk+kStride]-x[ijk+jStride-kStride]+x[ijk-kStride])  \
+        + (BETA_K(+kStride+1      )   -BETA_K(+kStride-1      )   ) * (x[ijk+kStride+1      ]-x[ijk+1      ]-x[ijk+kStride-1      ]+x[ijk-1      ])  \
+        + (BETA_K(+kStride+jStride)   -BETA_K(+kStride-jStride)   ) * (x[ijk+kStride+jStride]-x[ijk+jStride]-x[ijk+kStride-jStride]+x[ijk-jStride])  \
       )                                                                                                                                              \
     )                                                                                                                                                \
   )
   #else // Poisson...
-  #define apply_op_ijk(x)                                                                                                                            \
+  #define apply_op_variable_ijk(x)                                                                                                                   \
   (                                                                                                                                                  \
    -b*h2inv*(                                                                                                                                        \
       STENCIL_TWELFTH*(                                                                                                                              \
-        + beta_i[ijk        ]*( 15.0*(x[ijk-1      ]-x[ijk]) - (x[ijk-2        ]-x[ijk+1      ]) )                                                   \
-        + beta_i[ijk+1      ]*( 15.0*(x[ijk+1      ]-x[ijk]) - (x[ijk+2        ]-x[ijk-1      ]) )                                                   \
-        + beta_j[ijk        ]*( 15.0*(x[ijk-jStride]-x[ijk]) - (x[ijk-2*jStride]-x[ijk+jStride]) )                                                   \
-        + beta_j[ijk+jStride]*( 15.0*(x[ijk+jStride]-x[ijk]) - (x[ijk+2*jStride]-x[ijk-jStride]) )                                                   \
-        + beta_k[ijk        ]*( 15.0*(x[ijk-kStride]-x[ijk]) - (x[ijk-2*kStride]-x[ijk+kStride]) )                                                   \
-        + beta_k[ijk+kStride]*( 15.0*(x[ijk+kStride]-x[ijk]) - (x[ijk+2*kStride]-x[ijk-kStride]) )                                                   \
+        + BETA_I(       0)   *( 15.0*(x[ijk-1      ]-x[ijk]) - (x[ijk-2        ]-x[ijk+1      ]) )                                                   \
+        + BETA_I(+1      )   *( 15.0*(x[ijk+1      ]-x[ijk]) - (x[ijk+2        ]-x[ijk-1      ]) )                                                   \
+        + BETA_J(       0)   *( 15.0*(x[ijk-jStride]-x[ijk]) - (x[ijk-2*jStride]-x[ijk+jStride]) )                                                   \
+        + BETA_J(+jStride)   *( 15.0*(x[ijk+jStride]-x[ijk]) - (x[ijk+2*jStride]-x[ijk-jStride]) )                                                   \
+        + BETA_K(       0)   *( 15.0*(x[ijk-kStride]-x[ijk]) - (x[ijk-2*kStride]-x[ijk+kStride]) )                                                   \
+        + BETA_K(+kStride)   *( 15.0*(x[ijk+kStride]-x[ijk]) - (x[ijk+2*kStride]-x[ijk-kStride]) )                                                   \
       )                                                                                                                                              \
       + 0.25*STENCIL_TWELFTH*(                                                                                                                       \
-        + (beta_i[ijk        +jStride]-beta_i[ijk        -jStride]) * (x[ijk-1      +jStride]-x[ijk+jStride]-x[ijk-1      -jStride]+x[ijk-jStride])  \
-        + (beta_i[ijk        +kStride]-beta_i[ijk        -kStride]) * (x[ijk-1      +kStride]-x[ijk+kStride]-x[ijk-1      -kStride]+x[ijk-kStride])  \
-        + (beta_j[ijk        +1      ]-beta_j[ijk        -1      ]) * (x[ijk-jStride+1      ]-x[ijk+1      ]-x[ijk-jStride-1      ]+x[ijk-1      ])  \
-        + (beta_j[ijk        +kStride]-beta_j[ijk        -kStride]) * (x[ijk-jStride+kStride]-x[ijk+kStride]-x[ijk-jStride-kStride]+x[ijk-kStride])  \
-        + (beta_k[ijk        +1      ]-beta_k[ijk        -1      ]) * (x[ijk-kStride+1      ]-x[ijk+1      ]-x[ijk-kStride-1      ]+x[ijk-1      ])  \
-        + (beta_k[ijk        +jStride]-beta_k[ijk        -jStride]) * (x[ijk-kStride+jStride]-x[ijk+jStride]-x[ijk-kStride-jStride]+x[ijk-jStride])  \
+        + (BETA_I(        +jStride)   -BETA_I(        -jStride)   ) * (x[ijk-1      +jStride]-x[ijk+jStride]-x[ijk-1      -jStride]+x[ijk-jStride])  \
+        + (BETA_I(        +kStride)   -BETA_I(        -kStride)   ) * (x[ijk-1      +kStride]-x[ijk+kStride]-x[ijk-1      -kStride]+x[ijk-kStride])  \
+        + (BETA_J(        +1      )   -BETA_J(        -1      )   ) * (x[ijk-jStride+1      ]-x[ijk+1      ]-x[ijk-jStride-1      ]+x[ijk-1      ])  \
+        + (BETA_J(        +kStride)   -BETA_J(        -kStride)   ) * (x[ijk-jStride+kStride]-x[ijk+kStride]-x[ijk-jStride-kStride]+x[ijk-kStride])  \
+        + (BETA_K(        +1      )   -BETA_K(        -1      )   ) * (x[ijk-kStride+1      ]-x[ijk+1      ]-x[ijk-kStride-1      ]+x[ijk-1      ])  \
+        + (BETA_K(        +jStride)   -BETA_K(        -jStride)   ) * (x[ijk-kStride+jStride]-x[ijk+jStride]-x[ijk-kStride-jStride]+x[ijk-jStride])  \
                                                                                                                                                      \
-        + (beta_i[ijk+1      +jStride]-beta_i[ijk+1      -jStride]) * (x[ijk+1      +jStride]-x[ijk+jStride]-x[ijk+1      -jStride]+x[ijk-jStride])  \
-        + (beta_i[ijk+1      +kStride]-beta_i[ijk+1      -kStride]) * (x[ijk+1      +kStride]-x[ijk+kStride]-x[ijk+1      -kStride]+x[ijk-kStride])  \
-        + (beta_j[ijk+jStride+1      ]-beta_j[ijk+jStride-1      ]) * (x[ijk+jStride+1      ]-x[ijk+1      ]-x[ijk+jStride-1      ]+x[ijk-1      ])  \
-        + (beta_j[ijk+jStride+kStride]-beta_j[ijk+jStride-kStride]) * (x[ijk+jStride+kStride]-x[ijk+kStride]-x[ijk+jStride-kStride]+x[ijk-kStride])  \
-        + (beta_k[ijk+kStride+1      ]-beta_k[ijk+kStride-1      ]) * (x[ijk+kStride+1      ]-x[ijk+1      ]-x[ijk+kStride-1      ]+x[ijk-1      ])  \
-        + (beta_k[ijk+kStride+jStride]-beta_k[ijk+kStride-jStride]) * (x[ijk+kStride+jStride]-x[ijk+jStride]-x[ijk+kStride-jStride]+x[ijk-jStride])  \
+        + (BETA_I(+1      +jStride)   -BETA_I(+1      -jStride)   ) * (x[ijk+1      +jStride]-x[ijk+jStride]-x[ijk+1      -jStride]+x[ijk-jStride])  \
+        + (BETA_I(+1      +kStride)   -BETA_I(+1      -kStride)   ) * (x[ijk+1      +kStride]-x[ijk+kStride]-x[ijk+1      -kStride]+x[ijk-kStride])  \
+        + (BETA_J(+jStride+1      )   -BETA_J(+jStride-1      )   ) * (x[ijk+jStride+1      ]-x[ijk+1      ]-x[ijk+jStride-1      ]+x[ijk-1      ])  \
+        + (BETA_J(+jStride+kStride)   -BETA_J(+jStride-kStride)   ) * (x[ijk+jStride+kStride]-x[ijk+kStride]-x[ijk+jStride-kStride]+x[ijk-kStride])  \
+        + (BETA_K(+kStride+1      )   -BETA_K(+kStride-1      )   ) * (x[ijk+kStride+1      ]-x[ijk+1      ]-x[ijk+kStride-1      ]+x[ijk-1      ])  \
+        + (BETA_K(+kStride+jStride)   -BETA_K(+kStride-jStride)   ) * (x[ijk+kStride+jStride]-x[ijk+jStride]-x[ijk+kStride-jStride]+x[ijk-jStride])  \
       )                                                                                                                                              \
     )                                                                                                                                                \
   )
   #endif
-#else // constant coefficient (don't bother differentiating between Poisson and Helmholtz)...
-  #define apply_op_ijk(x)                 \
-  (                                       \
-    a*x[ijk] - b*h2inv*STENCIL_TWELFTH*(  \
-       - 1.0*(x[ijk-2*kStride] +          \
-              x[ijk-2*jStride] +          \
-              x[ijk-2        ] +          \
-              x[ijk+2        ] +          \
-              x[ijk+2*jStride] +          \
-              x[ijk+2*kStride] )          \
-       +16.0*(x[ijk  -kStride] +          \
-              x[ijk  -jStride] +          \
-              x[ijk  -1      ] +          \
-              x[ijk  +1      ] +          \
-              x[ijk  +jStride] +          \
-              x[ijk  +kStride] )          \
-       -90.0*(x[ijk          ] )          \
-    )                                     \
+#endif
+// constant coefficient (don't bother differentiating between Poisson and Helmholtz)... alpha and the beta's are folded into a and b
+#define A_CONSTANT ( a*level->constant_alpha )
+#define B_CONSTANT ( b*level->constant_beta  )
+  #define apply_op_constant_ijk(x)                          \
+  (                                                         \
+    A_CONSTANT*x[ijk] - B_CONSTANT*h2inv*STENCIL_TWELFTH*(  \
+       - 1.0*(x[ijk-2*kStride] +                            \
+              x[ijk-2*jStride] +                            \
+              x[ijk-2        ] +                            \
+              x[ijk+2        ] +                            \
+              x[ijk+2*jStride] +                            \
+              x[ijk+2*kStride] )                            \
+       +16.0*(x[ijk  -kStride] +                            \
+              x[ijk  -jStride] +                            \
+              x[ijk  -1      ] +                            \
+              x[ijk  +1      ] +                            \
+              x[ijk  +jStride] +                            \
+              x[ijk  +kStride] )                            \
+       -90.0*(x[ijk          ] )                            \
+    )                                                       \
+  )
+//------------------------------------------------------------------------------------------------------------------------------
+// 2nd order (7-point) variant of the operator used on the coarse levels selected by --high-order-levels (level->low_order).
+// The finer (4th order) levels correct their own residuals, i.e. the coarse grid corrections are defect corrections.
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #ifdef USE_HELMHOLTZ
+  #define apply_op_variable_fv2_ijk(x)                  \
+  (                                                     \
+    a*ALPHA(0)*x[ijk]                                   \
+   -b*h2inv*(                                           \
+      + BETA_I(+1      )*( x[ijk+1      ] - x[ijk] )    \
+      + BETA_I(       0)*( x[ijk-1      ] - x[ijk] )    \
+      + BETA_J(+jStride)*( x[ijk+jStride] - x[ijk] )    \
+      + BETA_J(       0)*( x[ijk-jStride] - x[ijk] )    \
+      + BETA_K(+kStride)*( x[ijk+kStride] - x[ijk] )    \
+      + BETA_K(       0)*( x[ijk-kStride] - x[ijk] )    \
+    )                                                   \
+  )
+  #else // Poisson...
+  #define apply_op_variable_fv2_ijk(x)                  \
+  (                                                     \
+   -b*h2inv*(                                           \
+      + BETA_I(+1      )*( x[ijk+1      ] - x[ijk] )    \
+      + BETA_I(       0)*( x[ijk-1      ] - x[ijk] )    \
+      + BETA_J(+jStride)*( x[ijk+jStride] - x[ijk] )    \
+      + BETA_J(       0)*( x[ijk-jStride] - x[ijk] )    \
+      + BETA_K(+kStride)*( x[ijk+kStride] - x[ijk] )    \
+      + BETA_K(       0)*( x[ijk-kStride] - x[ijk] )    \
+    )                                                   \
   )
+  #endif
 #endif
+  #define apply_op_constant_fv2_ijk(x)      \
+  (                                         \
+    A_CONSTANT*x[ijk] - B_CONSTANT*h2inv*(  \
+      + x[ijk+1      ]                      \
+      + x[ijk-1      ]                      \
+      + x[ijk+jStride]                      \
+      + x[ijk-jStride]                      \
+      + x[ijk+kStride]                      \
+      + x[ijk-kStride]                      \
+      - x[ijk        ]*6.0                  \
+    )                                       \
+  )
+//------------------------------------------------------------------------------------------------------------------------------
+#ifdef STENCIL_VARIABLE_COEFFICIENT // levels whose alpha and beta's are constant (level->constant_coefficients) have no coefficient vectors
+  #define apply_op_fv4_ijk(x) ( level->constant_coefficients ? apply_op_constant_ijk(x)     : apply_op_variable_ijk(x)     )
+  #define apply_op_fv2_ijk(x) ( level->constant_coefficients ? apply_op_constant_fv2_ijk(x) : apply_op_variable_fv2_ijk(x) )
+#else
+  #define apply_op_fv4_ijk(x) apply_op_constant_ijk(x)
+  #define apply_op_fv2_ijk(x) apply_op_constant_fv2_ijk(x)
+#endif
+#define apply_op_ijk(x) ( level->low_order ? apply_op_fv2_ijk(x) : apply_op_fv4_ijk(x) )
+//------------------------------------------------------------------------------------------------------------------------------
+// Analytic rows (see rebuild_operator_blackbox())... the diagonal (Aii) and the l1 norm of the off-diagonal (sumAbsAij) of a row
+// whose stencil does not reach the domain boundary.  With 4 colors in each dimension, the cells 2 away on either side share a
+// color and are thus summed before taking the magnitude (as the probes would).
+#define STENCIL_ANALYTIC_COLORS 4
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #define dBETA(B,o,d) ( B((o)+(d)) - B((o)-(d)) ) // derivative of face coefficient B (at offset o) in the direction d
+  #define Mi() ( dBETA(BETA_J,0,1      )+dBETA(BETA_K,0,1      )+dBETA(BETA_J,jStride,1      )+dBETA(BETA_K,kStride,1      ) )
+  #define Mj() ( dBETA(BETA_I,0,jStride)+dBETA(BETA_K,0,jStride)+dBETA(BETA_I,1      ,jStride)+dBETA(BETA_K,kStride,jStride) )
+  #define Mk() ( dBETA(BETA_I,0,kStride)+dBETA(BETA_J,0,kStride)+dBETA(BETA_I,1      ,kStride)+dBETA(BETA_J,jStride,kStride) )
+  #define sumAbsEdges(A,a1,B,b1) /* the 4 edges in the plane of dimensions A and B */ \
+  ( fabs(dBETA(A,0,b1)-dBETA(B,b1,a1)) + fabs(dBETA(A,0,b1)+dBETA(B,0,a1)) + fabs(dBETA(A,a1,b1)+dBETA(B,b1,a1)) + fabs(dBETA(A,a1,b1)-dBETA(B,0,a1)) )
+  #ifdef USE_HELMHOLTZ
+  #define Aii_variable_ijk() ( a*ALPHA(0) + b*h2inv*STENCIL_TWELFTH*15.0*( BETA_I(0)+BETA_I(1)+BETA_J(0)+BETA_J(jStride)+BETA_K(0)+BETA_K(kStride) ) )
+  #else
+  #define Aii_variable_ijk() (              b*h2inv*STENCIL_TWELFTH*15.0*( BETA_I(0)+BETA_I(1)+BETA_J(0)+BETA_J(jStride)+BETA_K(0)+BETA_K(kStride) ) )
+  #endif
+  #define sumAbsAij_variable_ijk()                                                                                                                   \
+  (                                                                                                                                                  \
+    fabs(b*h2inv)*(                                                                                                                                  \
+      fabs( STENCIL_TWELFTH*(15.0*BETA_I(0)+     BETA_I(1      )) + 0.25*STENCIL_TWELFTH*Mi() ) +                                                   \
+      fabs( STENCIL_TWELFTH*(     BETA_I(0)+15.0*BETA_I(1      )) - 0.25*STENCIL_TWELFTH*Mi() ) +                                                   \
+      fabs( STENCIL_TWELFTH*(15.0*BETA_J(0)+     BETA_J(jStride)) + 0.25*STENCIL_TWELFTH*Mj() ) +                                                   \
+      fabs( STENCIL_TWELFTH*(     BETA_J(0)+15.0*BETA_J(jStride)) - 0.25*STENCIL_TWELFTH*Mj() ) +                                                   \
+      fabs( STENCIL_TWELFTH*(15.0*BETA_K(0)+     BETA_K(kStride)) + 0.25*STENCIL_TWELFTH*Mk() ) +                                                   \
+      fabs( STENCIL_TWELFTH*(     BETA_K(0)+15.0*BETA_K(kStride)) - 0.25*STENCIL_TWELFTH*Mk() ) +                                                   \
+      STENCIL_TWELFTH*( fabs(BETA_I(0)+BETA_I(1)) + fabs(BETA_J(0)+BETA_J(jStride)) + fabs(BETA_K(0)+BETA_K(kStride)) ) +                           \
+      0.25*STENCIL_TWELFTH*( sumAbsEdges(BETA_I,1,BETA_J,jStride) + sumAbsEdges(BETA_I,1,BETA_K,kStride) + sumAbsEdges(BETA_J,jStride,BETA_K,kStride) ) \
+    )                                                                                                                                                \
+  )
+#endif
+#define       Aii_constant_ijk() ( A_CONSTANT + B_CONSTANT*h2inv*STENCIL_TWELFTH*90.0 )
+#define sumAbsAij_constant_ijk() ( fabs(B_CONSTANT*h2inv)*STENCIL_TWELFTH*(6.0*16.0+3.0*2.0) )
+// the 2nd order variant's neighbors are all of different colors...
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #ifdef USE_HELMHOLTZ
+  #define Aii_variable_fv2_ijk() ( a*ALPHA(0) + b*h2inv*( BETA_I(0)+BETA_I(1)+BETA_J(0)+BETA_J(jStride)+BETA_K(0)+BETA_K(kStride) ) )
+  #else
+  #define Aii_variable_fv2_ijk() (              b*h2inv*( BETA_I(0)+BETA_I(1)+BETA_J(0)+BETA_J(jStride)+BETA_K(0)+BETA_K(kStride) ) )
+  #endif
+  #define sumAbsAij_variable_fv2_ijk() ( fabs(b*h2inv)*( fabs(BETA_I(0))+fabs(BETA_I(1))+fabs(BETA_J(0))+fabs(BETA_J(jStride))+fabs(BETA_K(0))+fabs(BETA_K(kStride)) ) )
+#endif
+#define       Aii_constant_fv2_ijk() ( A_CONSTANT + B_CONSTANT*h2inv*6.0 )
+#define sumAbsAij_constant_fv2_ijk() ( fabs(B_CONSTANT*h2inv)*6.0 )
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #define       Aii_fv4_ijk() ( level->constant_coefficients ?           Aii_constant_ijk() :           Aii_variable_ijk() )
+  #define sumAbsAij_fv4_ijk() ( level->constant_coefficients ?     sumAbsAij_constant_ijk() :     sumAbsAij_variable_ijk() )
+  #define       Aii_fv2_ijk() ( level->constant_coefficients ?       Aii_constant_fv2_ijk() :       Aii_variable_fv2_ijk() )
+  #define sumAbsAij_fv2_ijk() ( level->constant_coefficients ? sumAbsAij_constant_fv2_ijk() : sumAbsAij_variable_fv2_ijk() )
+#else
+  #define       Aii_fv4_ijk()           Aii_constant_ijk()
+  #define sumAbsAij_fv4_ijk()     sumAbsAij_constant_ijk()
+  #define       Aii_fv2_ijk()       Aii_constant_fv2_ijk()
+  #define sumAbsAij_fv2_ijk() sumAbsAij_constant_fv2_ijk()
+#endif
+#define       Aii_ijk() ( level->low_order ?       Aii_fv2_ijk() :       Aii_fv4_ijk() )
+#define sumAbsAij_ijk() ( level->low_order ? sumAbsAij_fv2_ijk() : sumAbsAij_fv4_ijk() )
+//------------------------------------------------------------------------------------------------------------------------------
+// k-line coefficients (see operators/zline.c)... the coefficients of x[ijk-2*kStride], x[ijk-kStride], x[ijk+kStride], and x[ijk+2*kStride]
+// in the row of a cell whose stencil does not reach the domain boundary.  The mixed derivatives contribute Mk() to the nearest neighbors.
+#define STENCIL_LINE_COEFFICIENTS
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #define Akm2_variable_ijk() (  b*h2inv*STENCIL_TWELFTH*BETA_K(      0) )
+  #define Akm1_variable_ijk() ( -b*h2inv*STENCIL_TWELFTH*(15.0*BETA_K(0)+     BETA_K(kStride)+0.25*Mk()) )
+  #define Akp1_variable_ijk() ( -b*h2inv*STENCIL_TWELFTH*(     BETA_K(0)+15.0*BETA_K(kStride)-0.25*Mk()) )
+  #define Akp2_variable_ijk() (  b*h2inv*STENCIL_TWELFTH*BETA_K(kStride) )
+#endif
+#define Akm2_constant_ijk() (  B_CONSTANT*h2inv*STENCIL_TWELFTH      )
+#define Akm1_constant_ijk() ( -B_CONSTANT*h2inv*STENCIL_TWELFTH*16.0 )
+#define Akp1_constant_ijk() ( -B_CONSTANT*h2inv*STENCIL_TWELFTH*16.0 )
+#define Akp2_constant_ijk() (  B_CONSTANT*h2inv*STENCIL_TWELFTH      )
+#ifdef STENCIL_VARIABLE_COEFFICIENT
+  #define Akm2_fv4_ijk() ( level->constant_coefficients ? Akm2_constant_ijk() : Akm2_variable_ijk() )
+  #define Akm1_fv4_ijk() ( level->constant_coefficients ? Akm1_constant_ijk() : Akm1_variable_ijk() )
+  #define Akp1_fv4_ijk() ( level->constant_coefficients ? Akp1_constant_ijk() : Akp1_variable_ijk() )
+  #define Akp2_fv4_ijk() ( level->constant_coefficients ? Akp2_constant_ijk() : Akp2_variable_ijk() )
+  #define Akm1_fv2_ijk() ( level->constant_coefficients ? -B_CONSTANT*h2inv : -b*h2inv*BETA_K(      0) ) // the 2nd order variant is tridiagonal
+  #define Akp1_fv2_ijk() ( level->constant_coefficients ? -B_CONSTANT*h2inv : -b*h2inv*BETA_K(kStride) )
+#else
+  #define Akm2_fv4_ijk() Akm2_constant_ijk()
+  #define Akm1_fv4_ijk() Akm1_constant_ijk()
+  #define Akp1_fv4_ijk() Akp1_constant_ijk()
+  #define Akp2_fv4_ijk() Akp2_constant_ijk()
+  #define Akm1_fv2_ijk() ( -B_CONSTANT*h2inv )
+  #define Akp1_fv2_ijk() ( -B_CONSTANT*h2inv )
+#endif
+#define Akm2_ijk() ( level->low_order ?            0.0 : Akm2_fv4_ijk() )
+#define Akm1_ijk() ( level->low_order ? Akm1_fv2_ijk() : Akm1_fv4_ijk() )
+#define Akp1_ijk() ( level->low_order ? Akp1_fv2_ijk() : Akp1_fv4_ijk() )
+#define Akp2_ijk() ( level->low_order ?            0.0 : Akp2_fv4_ijk() )
 //------------------------------------------------------------------------------------------------------------------------------
 #ifdef STENCIL_VARIABLE_COEFFICIENT
 int stencil_get_radius(){return(2);} // stencil reaches out 2 cells
@@ -144,8 +300,32 @@ int stencil_get_shape(){return(STENCIL_SHAPE_NO_CORNERS);} // needs faces and ed
 int stencil_get_radius(){return(2);} // stencil reaches out 2 cells
 int stencil_get_shape(){return(STENCIL_SHAPE_STAR);} // needs just faces
 #endif
+int stencil_supports_constant_coefficients(){return(1);} // see apply_op_constant_ijk()
+int stencil_supports_low_order(){return(1);} // see apply_op_fv2_ijk()
 //------------------------------------------------------------------------------------------------------------------------------
 void rebuild_operator(level_type * level, level_type *fromLevel, double a, double b){
+  // alpha and beta's are constant (and not stored)...
+  if(level->constant_coefficients && !level->use_cuda){
+    int r = level->low_order ? 1 : 2;
+    int wraps = (level->dim.i<2*r+1) || (level->dim.j<2*r+1) || (level->dim.k<2*r+1); // a periodic stencil would reach the same cell twice
+    if( (level->boundary_condition.type == BC_PERIODIC) && !wraps ){
+      // every row is the interior stencil... D^{-1}, l1^{-1}, and the dominant eigenvalue are known analytically
+      double h2inv = 1.0/(level->h*level->h);
+      double Aii       = level->low_order ? A_CONSTANT + B_CONSTANT*h2inv*6.0 : A_CONSTANT + B_CONSTANT*h2inv*90.0*STENCIL_TWELFTH;
+      double sumAbsAij = level->low_order ?              B_CONSTANT*h2inv*6.0 :              B_CONSTANT*h2inv*(6.0*16.0+6.0*1.0)*STENCIL_TWELFTH;
+      init_vector(level,VECTOR_DINV ,1.0/Aii);
+      init_vector(level,VECTOR_L1INV,(Aii>=1.5*sumAbsAij) ? 1.0/Aii : 1.0/(Aii+0.5*sumAbsAij));
+      level->dominant_eigenvalue_of_DinvA = (Aii+sumAbsAij)/Aii;
+      if(level->my_rank==0){fprintf(stdout,"  constant coefficients for level h=%e... lambda_max = %1.15e\n",level->h,level->dominant_eigenvalue_of_DinvA);fflush(stdout);}
+    }else{
+      // the high-order boundary conditions change the diagonal of the rows near the domain boundary... use the black box (with the constant stencil)
+      rebuild_operator_blackbox(level,a,b,4);
+    }
+    exchange_boundary(level,VECTOR_DINV ,STENCIL_SHAPE_BOX);
+    exchange_boundary(level,VECTOR_L1INV,STENCIL_SHAPE_BOX);
+    return;
+  }
+
   // form restriction of alpha[], beta_*[] coefficients from fromLevel
   if(fromLevel != NULL){
     restriction(level,VECTOR_ALPHA ,fromLevel,VECTOR_ALPHA ,RESTRICT_CELL  );
@@ -154,15 +334,20 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
     restriction(level,VECTOR_BETA_K,fromLevel,VECTOR_BETA_K,RESTRICT_FACE_K);
   } // else case assumes alpha/beta have been set
 
-  // extrapolate the beta's into the ghost zones (needed for mixed derivatives)
-  extrapolate_betas(level);
-  //initialize_problem(level,level->h,a,b); // approach used for testing smooth beta's; destroys the black box nature of the solver
-
   // exchange alpha/beta/...  (must be done before calculating Dinv)
   exchange_boundary(level,VECTOR_ALPHA ,STENCIL_SHAPE_BOX); // safe
-  exchange_boundary(level,VECTOR_BETA_I,STENCIL_SHAPE_BOX);
-  exchange_boundary(level,VECTOR_BETA_J,STENCIL_SHAPE_BOX);
-  exchange_boundary(level,VECTOR_BETA_K,STENCIL_SHAPE_BOX);
+  exchange_boundary_faces(level,VECTOR_BETA_I,0);
+  exchange_boundary_faces(level,VECTOR_BETA_J,1);
+  exchange_boundary_faces(level,VECTOR_BETA_K,2);
+
+  // extrapolate the beta's into the ghost zones beyond the domain (needed for mixed derivatives)... reads the exchanged beta's
+  if(!level->low_order)extrapolate_betas(level);
+  //initialize_problem(level,level->h,a,b); // approach used for testing smooth beta's; destroys the black box nature of the solver
+
+  // the black box rebuild applies the operator and thus needs the packed alpha/beta's
+  #ifdef USE_PACKED_COEFFICIENTS
+  pack_coefficients(level);
+  #endif
 
   // black box rebuild of D^{-1}, l1^{-1}, dominant eigenvalue, ...
   rebuild_operator_blackbox(level,a,b,4);
@@ -170,45 +355,45 @@ void rebuild_operator(level_type * level, level_type *fromLevel, double a, doubl
   // exchange Dinv/L1inv/...
   exchange_boundary(level,VECTOR_DINV ,STENCIL_SHAPE_BOX); // safe
   exchange_boundary(level,VECTOR_L1INV,STENCIL_SHAPE_BOX);
+  #ifdef USE_PACKED_COEFFICIENTS
+  pack_coefficients(level);
+  #endif
 }
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-#ifdef  USE_GSRB
 #define GSRB_OOP
-#define NUM_SMOOTHS      3 // RBRBRB
-#include "operators/gsrb.c"
-#elif   USE_CHEBY
+#define GSRB_NUM_SMOOTHS      3 // RBRBRB
+#define CHEBYSHEV_NUM_SMOOTHS 1
+#define CHEBYSHEV_DEGREE      6 // i.e. one degree-6 polynomial smoother
+#define JACOBI_NUM_SMOOTHS    6
+#define SYMGS_NUM_SMOOTHS     2 // FBFB
+#define ZLINE_NUM_SMOOTHS     1 // FB
+#ifdef  USE_CHEBY
 #warning The Chebyshev smoother is currently underperforming for 4th order.  Please use -DUSE_GSRB or -DUSE_JACOBI
-#define NUM_SMOOTHS      1
-#define CHEBYSHEV_DEGREE 6 // i.e. one degree-6 polynomial smoother
-#include "operators/chebyshev.c"
-#elif   USE_JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_L1JACOBI
-#define NUM_SMOOTHS      6
-#include "operators/jacobi.c"
-#elif   USE_SYMGS
-#define NUM_SMOOTHS      2 // FBFB
-#include "operators/symgs.c"
-#else
-#error You must compile with either -DUSE_GSRB, -DUSE_CHEBY, -DUSE_JACOBI, -DUSE_L1JACOBI, or -DUSE_SYMGS
 #endif
+#include "operators/packed.c"
+#include "operators/smoothers.c"
 #include "operators/residual.c"
 #include "operators/apply_op.c"
 #include "operators/rebuild.c"
 //------------------------------------------------------------------------------------------------------------------------------
 #include "operators/blockCopy.c"
+#include "operators/unpack.c"
+#include "operators/comm_thread.c"
 #include "operators/misc.c"
 #include "operators/exchange_boundary.c"
 #include "operators/boundary_fv.c"
+#include "operators/tasks.c"
 #include "operators/restriction.c"
 #include "operators/interpolation_v2.c"
 #include "operators/interpolation_v4.c"
 //------------------------------------------------------------------------------------------------------------------------------
 void interpolation_vcycle(level_type * level_f, int id_f, double prescale_f, level_type *level_c, int id_c){interpolation_v2(level_f,id_f,prescale_f,level_c,id_c);}
-void interpolation_fcycle(level_type * level_f, int id_f, double prescale_f, level_type *level_c, int id_c){interpolation_v4(level_f,id_f,prescale_f,level_c,id_c);}
+void interpolation_fcycle(level_type * level_f, int id_f, double prescale_f, level_type *level_c, int id_c){
+  if(level_c->low_order)interpolation_v2(level_f,id_f,prescale_f,level_c,id_c); // 2nd order coarse levels have only 1 ghost zone
+                   else interpolation_v4(level_f,id_f,prescale_f,level_c,id_c);
+}
 //------------------------------------------------------------------------------------------------------------------------------
 #include "operators/problem.fv.c"
 //------------------------------------------------------------------------------------------------------------------------------
@@ -11,20 +11,39 @@
 #define RESTRICT_FACE_J 2
 #define RESTRICT_FACE_K 3
 //------------------------------------------------------------------------------------------------------------------------------
+#define SMOOTHER_GSRB     0
+#define SMOOTHER_CHEBY    1
+#define SMOOTHER_JACOBI   2
+#define SMOOTHER_L1JACOBI 3
+#define SMOOTHER_SYMGS    4
+#define SMOOTHER_ZLINE    5
+#define NUM_SMOOTHERS     6
+//------------------------------------------------------------------------------------------------------------------------------
 int stencil_get_radius(); 
 int stencil_get_shape();
+int stencil_supports_constant_coefficients();
+int stencil_supports_low_order();
 //------------------------------------------------------------------------------------------------------------------------------
   void                  apply_op(level_type * level, int Ax_id,  int x_id, double a, double b);
   void                  residual(level_type * level, int res_id, int x_id, int rhs_id, double a, double b);
-  void                    smooth(level_type * level, int phi_id, int rhs_id, double a, double b);
+  void                    smooth(level_type * level, int phi_id, int rhs_id, double a, double b); // dispatches to the smoother selected by level->smoother
+  void       smooth_and_residual(level_type * level, int phi_id, int rhs_id, int res_id, double a, double b); // smooth() then residual(), possibly as one task graph (-DUSE_TASKS)
+   int                tasks_gsrb(level_type * level, int phi_id, int rhs_id, int res_id, double a, double b);
+   int      smoother_get_default();
+   int           smoother_get_id(const char *name);
+const char *   smoother_get_name(int smoother);
   void          rebuild_operator(level_type * level, level_type *fromLevel, double a, double b);
   void rebuild_operator_blackbox(level_type * level, double a, double b, int colors_in_each_dim);
+  void         pack_coefficients(level_type * level); // -DUSE_PACKED_COEFFICIENTS
 //------------------------------------------------------------------------------------------------------------------------------
   void               restriction(level_type * level_c, int id_c, level_type *level_f, int id_f, int restrictionType);
   void      interpolation_vcycle(level_type * level_f, int id_f, double prescale_f, level_type *level_c, int id_c); // interpolation used inside a v-cycle
   void      interpolation_fcycle(level_type * level_f, int id_f, double prescale_f, level_type *level_c, int id_c); // interpolation used in the f-cycle to create a new initial guess for the next finner v-cycle
 //------------------------------------------------------------------------------------------------------------------------------
   void         exchange_boundary(level_type * level, int id_a, int shape);
+  void   exchange_boundary_faces(level_type * level, int id_a, int dir);
+  void         comm_thread_start(); // -DUSE_COMM_THREAD
+  void          comm_thread_stop();
   void              apply_BCs_p1(level_type * level, int x_id, int shape); // piecewise (cell centered) linear
   void              apply_BCs_p2(level_type * level, int x_id, int shape); // piecewise (cell centered) quadratic
   void              apply_BCs_v1(level_type * level, int x_id, int shape); // volumetric linear
@@ -33,11 +33,19 @@ void apply_op(level_type * level, int Ax_id, int x_id, double a, double b){
     const double h2inv = 1.0/(level->h*level->h);
     const double * __restrict__ x      = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
           double * __restrict__ Ax     = level->my_boxes[box].vectors[        Ax_id] + ghosts*(1+jStride+kStride); 
+    #ifdef USE_PACKED_COEFFICIENTS
+    const double * __restrict__ coefs  = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+    #else
+    #ifdef USE_HELMHOLTZ
     const double * __restrict__ alpha  = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+    #endif
     const double * __restrict__ beta_i = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
     const double * __restrict__ beta_j = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
     const double * __restrict__ beta_k = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
-    const double * __restrict__  valid = level->my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride);
+    #endif
+    #ifdef STENCIL_FUSE_BC
+    const valid_region_type valid      = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+    #endif
 
     for(k=klo;k<khi;k++){
     for(j=jlo;j<jhi;j++){
@@ -5,9 +5,64 @@
 //------------------------------------------------------------------------------------------------------------------------------
 // Based on Yousef Saad's Iterative Methods for Sparse Linear Algebra, Algorithm 12.1, page 399
 //------------------------------------------------------------------------------------------------------------------------------
-void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
-  if((CHEBYSHEV_DEGREE*NUM_SMOOTHS)&1){
-    fprintf(stderr,"error... CHEBYSHEV_DEGREE*NUM_SMOOTHS must be even for the chebyshev smoother...\n");
+// one chebyshev step (s) on each box extended by depth cells into its ghost zones (but not beyond the domain).  Used by the communication-avoiding
+// variant which exchanges depth steps*radius once.  Each step then reads radius cells beyond the region it updates and so the region shrinks by radius each step.
+// The extended regions are not covered by my_blocks, so threads are spread across (box,plane) pairs.
+// NOTE, the redundant updates reproduce the owning box's only if the ghost zone beta's beyond (and on) the domain boundary match the owner's
+// (see exchange_boundary_faces() and extrapolate_betas()).  MGBuild() checks the result against the exchange-every-step smoother.
+void chebyshev_extended(level_type * level, int x_id, int rhs_id, double a, double b, int s, double c1, double c2, int depth){
+  const int ghosts = level->box_ghosts;
+  const int    dim = level->box_dim;
+  const int planes = dim+2*depth;
+  int n;
+  #ifdef _OPENMP
+  #pragma omp parallel for private(n) schedule(static)
+  #endif
+  for(n=0;n<level->num_my_boxes*planes;n++){
+    const int box = n/planes;
+    const int   k = n%planes - depth;
+    const int jStride = level->my_boxes[box].jStride;
+    const int kStride = level->my_boxes[box].kStride;
+    const double h2inv = 1.0/(level->h*level->h);
+    const double * __restrict__ rhs      = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+    #ifdef USE_PACKED_COEFFICIENTS
+    const double * __restrict__ coefs    = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+    #else
+    #ifdef USE_HELMHOLTZ
+    const double * __restrict__ alpha    = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+    #endif
+    const double * __restrict__ beta_i   = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
+    const double * __restrict__ beta_j   = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
+    const double * __restrict__ beta_k   = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+    #endif
+    const double * __restrict__ Dinv     = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
+    const valid_region_type valid        = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+    const double * __restrict__ x_n      = level->my_boxes[box].vectors[((s&1)==0) ? x_id : VECTOR_TEMP] + ghosts*(1+jStride+kStride);
+    const double * __restrict__ x_nm1    = level->my_boxes[box].vectors[((s&1)==0) ? VECTOR_TEMP : x_id] + ghosts*(1+jStride+kStride);
+          double * __restrict__ x_np1    = level->my_boxes[box].vectors[((s&1)==0) ? VECTOR_TEMP : x_id] + ghosts*(1+jStride+kStride);
+    const int ilo = (-depth>valid.lo.i) ? -depth : valid.lo.i;
+    const int jlo = (-depth>valid.lo.j) ? -depth : valid.lo.j;
+    const int ihi = (dim+depth<valid.hi.i) ? dim+depth : valid.hi.i;
+    const int jhi = (dim+depth<valid.hi.j) ? dim+depth : valid.hi.j;
+    if( (k<valid.lo.k) || (k>=valid.hi.k) )continue;
+    int i,j;
+    for(j=jlo;j<jhi;j++){
+    for(i=ilo;i<ihi;i++){
+      const int ijk = i + j*jStride + k*kStride;
+      const double Ax_n   = apply_op_ijk(x_n);
+      const double lambda =     Dinv_ijk();
+      x_np1[ijk] = x_n[ijk] + c1*(x_n[ijk]-x_nm1[ijk]) + c2*lambda*(rhs[ijk]-Ax_n);
+    }}
+  }
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+void smooth_chebyshev(level_type * level, int x_id, int rhs_id, double a, double b){
+  const int num_smooths = (level->num_smooths     >0) ? level->num_smooths      : CHEBYSHEV_NUM_SMOOTHS;
+  const int degree      = (level->chebyshev_degree>0) ? level->chebyshev_degree : CHEBYSHEV_DEGREE;
+  if((degree*num_smooths)&1){
+    fprintf(stderr,"error... CHEBYSHEV_DEGREE*CHEBYSHEV_NUM_SMOOTHS must be even for the chebyshev smoother...\n");
     exit(0);
   }
   if( (level->dominant_eigenvalue_of_DinvA<=0.0) && (level->my_rank==0) )fprintf(stderr,"dominant_eigenvalue_of_DinvA <= 0.0 !\n");
@@ -19,8 +74,8 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
 
   int compute_c1_c2 = 0;
   // allocate heap memory for coefficients
-  if (level->chebyshev_c1 == NULL) { level->chebyshev_c1 = (double*)um_malloc(CHEBYSHEV_DEGREE * sizeof(double), level->um_access_policy); compute_c1_c2 = 1; }
-  if (level->chebyshev_c2 == NULL) { level->chebyshev_c2 = (double*)um_malloc(CHEBYSHEV_DEGREE * sizeof(double), level->um_access_policy); compute_c1_c2 = 1; }
+  if (level->chebyshev_c1 == NULL) { level->chebyshev_c1 = (double*)um_malloc(degree * sizeof(double), level->um_access_policy); compute_c1_c2 = 1; }
+  if (level->chebyshev_c2 == NULL) { level->chebyshev_c2 = (double*)um_malloc(degree * sizeof(double), level->um_access_policy); compute_c1_c2 = 1; }
 
   // compute the Chebyshev coefficients...
   double beta     = 1.000*level->dominant_eigenvalue_of_DinvA;
@@ -28,6 +83,7 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
 //double alpha    = 0.250000*beta;
 //double alpha    = 0.166666*beta;
   double alpha    = 0.125000*beta;
+  if( (level->smallest_eigenvalue_of_DinvA>alpha) && (level->smallest_eigenvalue_of_DinvA<beta) )alpha = level->smallest_eigenvalue_of_DinvA; // the spectrum (estimated by MGEstimateEigenvalues) is narrower than [beta/8,beta]
   double theta    = 0.5*(beta+alpha);		// center of the spectral ellipse
   double delta    = 0.5*(beta-alpha);		// major axis?
   double sigma = theta/delta;
@@ -36,8 +92,8 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
   double *chebyshev_c1 = level->chebyshev_c1;	// + c1*(x_n-x_nm1) == rho_n*rho_nm1
   double *chebyshev_c2 = level->chebyshev_c2;	// + c2*(b-Ax_n)
 #else
-  double chebyshev_c1[CHEBYSHEV_DEGREE];	// + c1*(x_n-x_nm1) == rho_n*rho_nm1
-  double chebyshev_c2[CHEBYSHEV_DEGREE];	// + c2*(b-Ax_n)
+  double chebyshev_c1[degree];			// + c1*(x_n-x_nm1) == rho_n*rho_nm1
+  double chebyshev_c2[degree];			// + c2*(b-Ax_n)
 #endif
   // compute coefficients only once if using gpu for this level
   if (!level->use_cuda || compute_c1_c2) {
@@ -46,7 +102,7 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
     // now compute coefficients on cpu
     chebyshev_c1[0] = 0.0;
     chebyshev_c2[0] = 1/theta;
-    for(s=1;s<CHEBYSHEV_DEGREE;s++){
+    for(s=1;s<degree;s++){
       double rho_nm1 = rho_n;
       rho_n = 1.0/(2.0*sigma - rho_nm1);
       chebyshev_c1[s] = rho_n*rho_nm1;
@@ -55,7 +111,25 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
   }
 
 
-  for(s=0;s<CHEBYSHEV_DEGREE*NUM_SMOOTHS;s++){
+  // communication-avoiding... exchange a ghost zone of depth steps*radius once and then apply steps steps on shrinking regions (see chebyshev_extended())
+  const int steps = ( level->use_cuda || level->brick || (level->chebyshev_steps<2) ) ? 1 : level->chebyshev_steps;
+  if(steps>1)exchange_boundary(level,rhs_id,STENCIL_SHAPE_BOX); // the extended regions also read rhs
+
+  for(s=0;s<degree*num_smooths;s++){
+    if(steps>1){
+      int x_n_id   = ((s&1)==0) ? x_id : VECTOR_TEMP;
+      int x_nm1_id = ((s&1)==0) ? VECTOR_TEMP : x_id;
+      if((s%steps)==0){
+        exchange_boundary(level,x_n_id,STENCIL_SHAPE_BOX);apply_BCs(level,x_n_id,STENCIL_SHAPE_BOX);
+        if((s%degree)!=0)exchange_boundary(level,x_nm1_id,STENCIL_SHAPE_BOX); // x_{n-1} is also read (at each cell) unless this step restarts the polynomial
+      }
+      double _timeStart = getTime();
+      chebyshev_extended(level,x_id,rhs_id,a,b,s,chebyshev_c1[s%degree],chebyshev_c2[s%degree],(steps-1-(s%steps))*stencil_get_radius());
+      level->timers.smooth += (double)(getTime()-_timeStart);
+      if( ((s%steps)!=steps-1) && (s<degree*num_smooths-1) )apply_BCs(level,x_nm1_id,STENCIL_SHAPE_BOX); // the next step reads the BC's of x_{n+1}
+      continue;
+    }
+
     // get ghost zone data... Chebyshev ping pongs between x_id and VECTOR_TEMP
     if((s&1)==0){exchange_boundary(level,       x_id,stencil_get_shape());apply_BCs(level,       x_id,stencil_get_shape());}
             else{exchange_boundary(level,VECTOR_TEMP,stencil_get_shape());apply_BCs(level,VECTOR_TEMP,stencil_get_shape());}
@@ -82,12 +156,20 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
       const int kStride = level->my_boxes[box].kStride;
       const double h2inv = 1.0/(level->h*level->h);
       const double * __restrict__ rhs      = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+      #ifdef USE_PACKED_COEFFICIENTS
+      const double * __restrict__ coefs    = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+      #else
+      #ifdef USE_HELMHOLTZ
       const double * __restrict__ alpha    = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+      #endif
       const double * __restrict__ beta_i   = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
       const double * __restrict__ beta_j   = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
       const double * __restrict__ beta_k   = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+      #endif
       const double * __restrict__ Dinv     = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ valid    = level->my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride); // cell is inside the domain
+      #ifdef STENCIL_FUSE_BC
+      const valid_region_type valid        = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+      #endif
 
             double * __restrict__ x_np1;
       const double * __restrict__ x_n;
@@ -98,8 +180,8 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
                                else{x_n    = level->my_boxes[box].vectors[VECTOR_TEMP  ] + ghosts*(1+jStride+kStride);
                                     x_nm1  = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride); 
                                     x_np1  = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride);}
-      const double c1 = chebyshev_c1[s%CHEBYSHEV_DEGREE]; // limit polynomial to degree CHEBYSHEV_DEGREE.
-      const double c2 = chebyshev_c2[s%CHEBYSHEV_DEGREE]; // limit polynomial to degree CHEBYSHEV_DEGREE.
+      const double c1 = chebyshev_c1[s%degree]; // limit polynomial to degree
+      const double c2 = chebyshev_c2[s%degree]; // limit polynomial to degree
 
       for(k=klo;k<khi;k++){
       for(j=jlo;j<jhi;j++){
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Communication thread (-DUSE_COMM_THREAD)
+// With MPI_THREAD_FUNNELED, messages only progress inside MPI_Waitall and thus not while threads pack buffers, copy local
+// ghost zones, or restrict/interpolate local boxes.  Here, one pthread per process acts as a communication engine.
+// Once the master thread has posted the Irecv's/Isend's of an exchange, restriction, or interpolation, it hands the
+// requests and the unpack list to this thread which waits on the messages and unpacks them (as they arrive) while the OpenMP
+// threads perform the on-process work.  The master thread makes no MPI calls until the job is complete and thus this
+// requires only MPI_THREAD_SERIALIZED (MPI_THREAD_MULTIPLE also works).
+// NOTE, run with one fewer OpenMP thread than cores per process so that the communication thread has a core of its own.
+//------------------------------------------------------------------------------------------------------------------------------
+#if defined(USE_COMM_THREAD) && defined(USE_MPI)
+#include <pthread.h>
+typedef struct {
+  level_type          *level;	// level on which to unpack (i.e. whose boxes are written)
+  int                     id;	// vector to unpack into
+  int              increment;	// unpack with IncrementBlock() (interpolation) rather than CopyBlock()
+  interpolation_block_type interpolate;	// or interpolate the coarse data in the buffers (-DUSE_RECEIVER_INTERPOLATION)
+  double            prescale;	// IncrementBlock() prescales the existing data
+  communicator_type    *comm;	// communicator whose receive buffers and unpack list (blocks[2]) are used
+  int              nMessages;	// number of MPI requests (receives first, then sends)
+  MPI_Request      *requests;
+  MPI_Status         *status;
+  double           time_wait;	// time spent waiting on MPI (filled in by the communication thread)
+  double         time_unpack;	// time spent unpacking (filled in by the communication thread)
+} comm_job_type;
+
+struct {
+  pthread_t          thread;
+  pthread_mutex_t      lock;
+  pthread_cond_t       cond;	// signaled when a job is posted, completed, or the thread should exit
+  int               running;
+  comm_job_type        *job;	// current job (NULL when idle)
+} comm_thread;
+
+
+void * comm_thread_main(void *arg){
+  pthread_mutex_lock(&comm_thread.lock);
+  while(1){
+    while( comm_thread.running && (comm_thread.job==NULL) )pthread_cond_wait(&comm_thread.cond,&comm_thread.lock);
+    if(!comm_thread.running)break;
+    comm_job_type *job = comm_thread.job;
+    pthread_mutex_unlock(&comm_thread.lock);
+
+    // unpack each receive buffer as it arrives and then complete the sends...
+    int num_recvs = job->comm->num_recvs;
+    unpack_in_arrival_order(job->level,job->id,job->increment,job->interpolate,job->prescale,job->comm,job->requests,job->status,0,&job->time_wait,&job->time_unpack);
+    double _timeStart = getTime();
+    MPI_Waitall(job->nMessages-num_recvs,job->requests+num_recvs,job->status);
+    job->time_wait += (getTime()-_timeStart);
+
+    pthread_mutex_lock(&comm_thread.lock);
+    comm_thread.job = NULL;
+    pthread_cond_broadcast(&comm_thread.cond);
+  }
+  pthread_mutex_unlock(&comm_thread.lock);
+  return(NULL);
+}
+
+
+void comm_thread_start(){
+  pthread_mutex_init(&comm_thread.lock,NULL);
+  pthread_cond_init(&comm_thread.cond,NULL);
+  comm_thread.running = 1;
+  comm_thread.job     = NULL;
+  if(pthread_create(&comm_thread.thread,NULL,comm_thread_main,NULL)){fprintf(stderr,"pthread_create failed - comm_thread_start\n");exit(0);}
+}
+
+
+void comm_thread_stop(){
+  pthread_mutex_lock(&comm_thread.lock);
+  comm_thread.running = 0;
+  pthread_cond_broadcast(&comm_thread.cond);
+  pthread_mutex_unlock(&comm_thread.lock);
+  pthread_join(comm_thread.thread,NULL);
+  pthread_cond_destroy(&comm_thread.cond);
+  pthread_mutex_destroy(&comm_thread.lock);
+}
+
+
+// hand the (already posted) requests and the unpack blocks to the communication thread
+void comm_thread_post(comm_job_type *job){
+  job->time_wait   = 0.0;
+  job->time_unpack = 0.0;
+  pthread_mutex_lock(&comm_thread.lock);
+  comm_thread.job = job;
+  pthread_cond_broadcast(&comm_thread.cond);
+  pthread_mutex_unlock(&comm_thread.lock);
+}
+
+
+// wait for the communication thread to complete the messages and the unpacks
+void comm_thread_wait(comm_job_type *job){
+  pthread_mutex_lock(&comm_thread.lock);
+  while(comm_thread.job==job)pthread_cond_wait(&comm_thread.cond,&comm_thread.lock);
+  pthread_mutex_unlock(&comm_thread.lock);
+}
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
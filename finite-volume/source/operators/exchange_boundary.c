@@ -34,6 +34,7 @@ void exchange_boundary(level_type * level, int id, int shape){
     #pragma omp parallel for schedule(dynamic,1)
     #endif
     for(n=0;n<level->exchange_ghosts[shape].num_recvs;n++){
+      if(level->exchange_ghosts[shape].recv_sizes[n]==0){recv_requests[n]=MPI_REQUEST_NULL;continue;} // everything was sent via a datatype
       MPI_Irecv(level->exchange_ghosts[shape].recv_buffers[n],
                 level->exchange_ghosts[shape].recv_sizes[n],
                 MPI_DOUBLE,
@@ -48,26 +49,61 @@ void exchange_boundary(level_type * level, int id, int shape){
   }
 
 
-  // pack MPI send buffers...
-  if(level->exchange_ghosts[shape].num_blocks[0]){
+  // post the zero-copy messages which are received directly into (sent directly from) the boxes of vector id...
+  #ifdef USE_MPI_DATATYPES
+  int nZeroCopy = 0;
+  if(level->exchange_ghosts[shape].zc_requests){
     _timeStart = getTime();
-    if(level->use_cuda) {
-      cuda_copy_block(*level,id,level->exchange_ghosts[shape],0);
-      cudaDeviceSynchronize();	// synchronize so the CPU sees the updated buffers which will be used for MPI transfers
-    }
-    else {
-    PRAGMA_THREAD_ACROSS_BLOCKS(level,buffer,level->exchange_ghosts[shape].num_blocks[0])
-    for(buffer=0;buffer<level->exchange_ghosts[shape].num_blocks[0];buffer++){
-      CopyBlock(level,id,&level->exchange_ghosts[shape].blocks[0][buffer]);
+    for(n=0;n<level->exchange_ghosts[shape].num_recvs;n++)if(level->exchange_ghosts[shape].recv_types[n]!=MPI_DATATYPE_NULL){
+      MPI_Irecv(level->vectors[id],1,level->exchange_ghosts[shape].recv_types[n],level->exchange_ghosts[shape].recv_ranks[n],my_tag|0x8,MPI_COMM_WORLD,&level->exchange_ghosts[shape].zc_requests[nZeroCopy++]);
     }
+    for(n=0;n<level->exchange_ghosts[shape].num_sends;n++)if(level->exchange_ghosts[shape].send_types[n]!=MPI_DATATYPE_NULL){
+      MPI_Isend(level->vectors[id],1,level->exchange_ghosts[shape].send_types[n],level->exchange_ghosts[shape].send_ranks[n],my_tag|0x8,MPI_COMM_WORLD,&level->exchange_ghosts[shape].zc_requests[nZeroCopy++]);
     }
     _timeEnd = getTime();
+    level->timers.ghostZone_send += (_timeEnd-_timeStart);
+  }
+  #endif
+
+
+  // pack MPI send buffers...
+  if(level->exchange_ghosts[shape].num_blocks[0] && level->use_cuda){
+    _timeStart = getTime();
+    cuda_copy_block(*level,id,level->exchange_ghosts[shape],0);
+    cudaDeviceSynchronize();	// synchronize so the CPU sees the updated buffers which will be used for MPI transfers
+    _timeEnd = getTime();
     level->timers.ghostZone_pack += (_timeEnd-_timeStart);
   }
 
  
+  // on the host, pack each MPI send buffer and post its Isend before packing the next...
+  if( (level->exchange_ghosts[shape].num_sends>0) && !level->use_cuda ){
+    for(n=0;n<level->exchange_ghosts[shape].num_sends;n++){
+      int b0 = level->exchange_ghosts[shape].pack_start[n  ];
+      int b1 = level->exchange_ghosts[shape].pack_start[n+1];
+      if(level->exchange_ghosts[shape].send_sizes[n]==0){send_requests[n]=MPI_REQUEST_NULL;continue;}
+      _timeStart = getTime();
+      PRAGMA_THREAD_ACROSS_BLOCKS(level,buffer,b1-b0)
+      for(buffer=b0;buffer<b1;buffer++){
+        CopyBlock(level,id,&level->exchange_ghosts[shape].blocks[0][buffer]);
+      }
+      _timeEnd = getTime();
+      MPI_Isend(level->exchange_ghosts[shape].send_buffers[n],
+                level->exchange_ghosts[shape].send_sizes[n],
+                MPI_DOUBLE,
+                level->exchange_ghosts[shape].send_ranks[n],
+                my_tag,
+                MPI_COMM_WORLD,
+                &send_requests[n]
+      ); 
+      level->timers.ghostZone_pack += (_timeEnd-_timeStart);
+      level->timers.ghostZone_send += (getTime()-_timeEnd);
+    }
+  }
+
+
   // loop through MPI send buffers and post Isend's...
-  if(level->exchange_ghosts[shape].num_sends>0){
+  if( (level->exchange_ghosts[shape].num_sends>0) && level->use_cuda ){
     _timeStart = getTime();
     #ifdef USE_MPI_THREAD_MULTIPLE
     #pragma omp parallel for schedule(dynamic,1)
@@ -85,6 +121,13 @@ void exchange_boundary(level_type * level, int id, int shape){
     _timeEnd = getTime();
     level->timers.ghostZone_send += (_timeEnd-_timeStart);
   }
+
+  // let the communication thread wait on the messages and unpack them while the local copies are performed...
+  #ifdef USE_COMM_THREAD
+  comm_job_type job = {level,id,0,NULL,1.0,&level->exchange_ghosts[shape],nMessages,level->exchange_ghosts[shape].requests,level->exchange_ghosts[shape].status,0.0,0.0};
+  int use_comm_thread = (nMessages>0) && (!level->use_cuda);
+  if(use_comm_thread)comm_thread_post(&job);
+  #endif
   #endif
 
 
@@ -107,6 +150,23 @@ void exchange_boundary(level_type * level, int id, int shape){
 
   // wait for MPI to finish...
   #ifdef USE_MPI 
+  #ifdef USE_COMM_THREAD
+  if(use_comm_thread){
+    comm_thread_wait(&job);
+    level->timers.ghostZone_wait   += job.time_wait;
+    level->timers.ghostZone_unpack += job.time_unpack;
+  }else
+  #endif
+  if(!level->use_cuda){
+  // unpack each MPI receive buffer as soon as it arrives and then complete the sends...
+  if(nMessages){
+    unpack_in_arrival_order(level,id,0,NULL,1.0,&level->exchange_ghosts[shape],recv_requests,level->exchange_ghosts[shape].status,1,&level->timers.ghostZone_wait,&level->timers.ghostZone_unpack);
+    _timeStart = getTime();
+    MPI_Waitall(level->exchange_ghosts[shape].num_sends,send_requests,level->exchange_ghosts[shape].status);
+    _timeEnd = getTime();
+    level->timers.ghostZone_wait += (_timeEnd-_timeStart);
+  }
+  }else{
   if(nMessages){
     _timeStart = getTime();
     MPI_Waitall(nMessages,level->exchange_ghosts[shape].requests,level->exchange_ghosts[shape].status);
@@ -121,20 +181,89 @@ void exchange_boundary(level_type * level, int id, int shape){
   // unpack MPI receive buffers 
   if(level->exchange_ghosts[shape].num_blocks[2]){
     _timeStart = getTime();
-    if(level->use_cuda) {
-      cuda_copy_block(*level,id,level->exchange_ghosts[shape],2);
-    }
-    else {
-    PRAGMA_THREAD_ACROSS_BLOCKS(level,buffer,level->exchange_ghosts[shape].num_blocks[2])
-    for(buffer=0;buffer<level->exchange_ghosts[shape].num_blocks[2];buffer++){
-      CopyBlock(level,id,&level->exchange_ghosts[shape].blocks[2][buffer]);
-    }
-    }
+    cuda_copy_block(*level,id,level->exchange_ghosts[shape],2);
     _timeEnd = getTime();
     level->timers.ghostZone_unpack += (_timeEnd-_timeStart);
   }
+  }
+  #ifdef USE_MPI_DATATYPES
+  if(nZeroCopy){
+    _timeStart = getTime();
+    MPI_Waitall(nZeroCopy,level->exchange_ghosts[shape].zc_requests,MPI_STATUSES_IGNORE);
+    _timeEnd = getTime();
+    level->timers.ghostZone_wait += (_timeEnd-_timeStart);
+  }
+  #endif
   #endif
 
  
   level->timers.ghostZone_total += (double)(getTime()-_timeCommunicationStart);
 }
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+// exchange the face-centered vector id (normal to dir = 0,1,2 for i,j,k) like exchange_boundary(level,id,STENCIL_SHAPE_BOX), but also copy the
+// faces on the high domain boundary.  Those lie in the first ghost zone of the boxes on that boundary (e.g. beta_i[dim]) which exchange_boundary()
+// never copies.  Thus, they are shifted into the boxes' cells (through VECTOR_TEMP) and exchanged so that boxes whose ghost zones extend along
+// that boundary (e.g. for the communication-avoiding chebyshev smoother) see the same boundary faces as the box which owns them.
+void exchange_boundary_faces(level_type * level, int id, int dir){
+  exchange_boundary(level,id,STENCIL_SHAPE_BOX);
+  if(level->boundary_condition.type == BC_PERIODIC)return; // no domain boundary
+
+  int box;
+  cudaDeviceSynchronize(); // CPU loops on managed memory
+  #ifdef _OPENMP
+  #pragma omp parallel for private(box) schedule(static)
+  #endif
+  for(box=0;box<level->num_my_boxes;box++){
+    const int     dim = level->box_dim;
+    const int jStride = level->my_boxes[box].jStride;
+    const int kStride = level->my_boxes[box].kStride;
+    const int  ghosts = level->my_boxes[box].ghosts;
+    const int   shift = (dir==0) ? 1 : (dir==1) ? jStride : kStride;
+    const double * __restrict__ face = level->my_boxes[box].vectors[         id] + ghosts*(1+jStride+kStride);
+          double * __restrict__ temp = level->my_boxes[box].vectors[VECTOR_TEMP] + ghosts*(1+jStride+kStride);
+    int i,j,k;
+    for(k=0;k<dim;k++){
+    for(j=0;j<dim;j++){
+    for(i=0;i<dim;i++){
+      int ijk = i + j*jStride + k*kStride;
+      temp[ijk] = face[ijk+shift]; // the face on the high side of each cell
+    }}}
+  }
+  exchange_boundary(level,VECTOR_TEMP,STENCIL_SHAPE_BOX);
+
+  cudaDeviceSynchronize();
+  #ifdef _OPENMP
+  #pragma omp parallel for private(box) schedule(static)
+  #endif
+  for(box=0;box<level->num_my_boxes;box++){
+    const int     dim = level->box_dim;
+    const int jStride = level->my_boxes[box].jStride;
+    const int kStride = level->my_boxes[box].kStride;
+    const int  ghosts = level->my_boxes[box].ghosts;
+    const int   shift = (dir==0) ? 1 : (dir==1) ? jStride : kStride;
+    const int     low[3] = {level->my_boxes[box].low.i,level->my_boxes[box].low.j,level->my_boxes[box].low.k};
+    const int domain[3] = {level->dim.i,level->dim.j,level->dim.k};
+    const double * __restrict__ temp = level->my_boxes[box].vectors[VECTOR_TEMP] + ghosts*(1+jStride+kStride);
+          double * __restrict__ face = level->my_boxes[box].vectors[         id] + ghosts*(1+jStride+kStride);
+    int lo[3],hi[3],d,n[3];
+    for(d=0;d<3;d++){lo[d]=-ghosts;hi[d]=dim+ghosts;}
+    lo[dir] = hi[dir] = domain[dir]-low[dir]; // box-relative index of the high boundary face
+    if( (lo[dir]<-ghosts) || (lo[dir]>=dim+ghosts) )continue;
+    hi[dir]++;
+    for(n[2]=lo[2];n[2]<hi[2];n[2]++){
+    for(n[1]=lo[1];n[1]<hi[1];n[1]++){
+    for(n[0]=lo[0];n[0]<hi[0];n[0]++){
+      int inside=1,mine=1;
+      for(d=0;d<3;d++)if(d!=dir){
+        if( (n[d]+low[d]<0) || (n[d]+low[d]>=domain[d]) )inside=0;
+        if( (n[d]<0) || (n[d]>=dim) )mine=0;
+      }
+      if(inside && !mine){
+        int ijk = n[0] + n[1]*jStride + n[2]*kStride;
+        face[ijk] = temp[ijk-shift];
+      }
+    }}}
+  }
+}
@@ -106,26 +106,44 @@ void interpolation_p1(level_type * level_f, int id_f, double prescale_f, level_t
 
 
   // pack MPI send buffers...
-  if(level_c->interpolation.num_blocks[0]>0){
+  if( (level_c->interpolation.num_blocks[0]>0) && level_f->use_cuda ){
     _timeStart = getTime();
-    if(level_f->use_cuda) {
-      cuda_interpolation_p1(*level_f,id_f,0.0,*level_c,id_c,level_c->interpolation,0);
-      cudaDeviceSynchronize(); // synchronize so the CPU sees the updated buffers
-    }
-    else {
-    PRAGMA_THREAD_ACROSS_BLOCKS(level_f,buffer,level_c->interpolation.num_blocks[0])
-    for(buffer=0;buffer<level_c->interpolation.num_blocks[0];buffer++){
-      // !!! prescale==0 because you don't want to increment the MPI buffer
-      interpolation_p1_block(level_f,id_f,0.0,level_c,id_c,&level_c->interpolation.blocks[0][buffer]);
-    }
-    }
+    cuda_interpolation_p1(*level_f,id_f,0.0,*level_c,id_c,level_c->interpolation,0);
+    cudaDeviceSynchronize(); // synchronize so the CPU sees the updated buffers
     _timeEnd = getTime();
     level_f->timers.interpolation_pack += (_timeEnd-_timeStart);
   }
 
 
+  // on the host, pack each MPI send buffer and post its Isend before packing the next...
+  if( (level_c->interpolation.num_sends>0) && !level_f->use_cuda ){
+    for(n=0;n<level_c->interpolation.num_sends;n++){
+      int b0 = level_c->interpolation.pack_start[n  ];
+      int b1 = level_c->interpolation.pack_start[n+1];
+      _timeStart = getTime();
+      PRAGMA_THREAD_ACROSS_BLOCKS(level_f,buffer,b1-b0)
+      for(buffer=b0;buffer<b1;buffer++){
+        // !!! prescale==0 because you don't want to increment the MPI buffer
+        if(level_c->interpolation.send_coarse)CopyBlock(level_c,id_c,&level_c->interpolation.blocks[0][buffer]); // the receiver interpolates
+                                         else interpolation_p1_block(level_f,id_f,0.0,level_c,id_c,&level_c->interpolation.blocks[0][buffer]);
+      }
+      _timeEnd = getTime();
+      MPI_Isend(level_c->interpolation.send_buffers[n],
+                level_c->interpolation.send_sizes[n],
+                MPI_DOUBLE,
+                level_c->interpolation.send_ranks[n],
+                my_tag,
+                MPI_COMM_WORLD,
+                &send_requests[n]
+      );
+      level_f->timers.interpolation_pack += (_timeEnd-_timeStart);
+      level_f->timers.interpolation_send += (getTime()-_timeEnd);
+    }
+  }
+
+
   // loop through MPI send buffers and post Isend's...
-  if(level_c->interpolation.num_sends>0){
+  if( (level_c->interpolation.num_sends>0) && level_f->use_cuda ){
     _timeStart = getTime();
     #ifdef USE_MPI_THREAD_MULTIPLE
     #pragma omp parallel for schedule(dynamic,1)
@@ -143,6 +161,13 @@ void interpolation_p1(level_type * level_f, int id_f, double prescale_f, level_t
     _timeEnd = getTime();
     level_f->timers.interpolation_send += (_timeEnd-_timeStart);
   }
+
+  // let the communication thread wait on the messages and unpack them while the local interpolations are performed...
+  #ifdef USE_COMM_THREAD
+  comm_job_type job = {level_f,id_f,1,level_f->interpolation.recv_coarse ? interpolation_p1_block : NULL,prescale_f,&level_f->interpolation,nMessages,level_f->interpolation.requests,level_f->interpolation.status,0.0,0.0};
+  int use_comm_thread = (nMessages>0) && (!level_f->use_cuda) && (!level_c->use_cuda);
+  if(use_comm_thread)comm_thread_post(&job);
+  #endif
   #endif
 
 
@@ -165,6 +190,23 @@ void interpolation_p1(level_type * level_f, int id_f, double prescale_f, level_t
 
   // wait for MPI to finish...
   #ifdef USE_MPI 
+  #ifdef USE_COMM_THREAD
+  if(use_comm_thread){
+    comm_thread_wait(&job);
+    level_f->timers.interpolation_wait   += job.time_wait;
+    level_f->timers.interpolation_unpack += job.time_unpack;
+  }else
+  #endif
+  if(!level_f->use_cuda){
+  // unpack each MPI receive buffer as soon as it arrives and then complete the sends...
+  if(nMessages>0){
+    unpack_in_arrival_order(level_f,id_f,1,level_f->interpolation.recv_coarse ? interpolation_p1_block : NULL,prescale_f,&level_f->interpolation,recv_requests,level_f->interpolation.status,1,&level_f->timers.interpolation_wait,&level_f->timers.interpolation_unpack);
+    _timeStart = getTime();
+    MPI_Waitall(level_c->interpolation.num_sends,send_requests,level_f->interpolation.status);
+    _timeEnd = getTime();
+    level_f->timers.interpolation_wait += (_timeEnd-_timeStart);
+  }
+  }else{
   if(nMessages>0){
     _timeStart = getTime();
     MPI_Waitall(nMessages,level_f->interpolation.requests,level_f->interpolation.status);
@@ -177,18 +219,11 @@ void interpolation_p1(level_type * level_f, int id_f, double prescale_f, level_t
   // unpack MPI receive buffers 
   if(level_f->interpolation.num_blocks[2]>0){
     _timeStart = getTime();
-    if(level_f->use_cuda) {
-      cuda_increment_block(*level_f,id_f,prescale_f,level_f->interpolation,2);
-    }
-    else {
-    PRAGMA_THREAD_ACROSS_BLOCKS(level_f,buffer,level_f->interpolation.num_blocks[2])
-    for(buffer=0;buffer<level_f->interpolation.num_blocks[2];buffer++){
-      IncrementBlock(level_f,id_f,prescale_f,&level_f->interpolation.blocks[2][buffer]);
-    }
-    }
+    cuda_increment_block(*level_f,id_f,prescale_f,level_f->interpolation,2);
     _timeEnd = getTime();
     level_f->timers.interpolation_unpack += (_timeEnd-_timeStart);
   }
+  }
   #endif 
  
  
@@ -5,20 +5,18 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include <stdint.h>
 //------------------------------------------------------------------------------------------------------------------------------
-void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
-  if(NUM_SMOOTHS&1){
-    fprintf(stderr,"error - NUM_SMOOTHS must be even...\n");
+// weighted Jacobi (l1==0) uses D^{-1} with a weight of 2/3, L1 Jacobi (l1==1) uses the inverse of the L1 row norm with a weight of 1
+void jacobi_smooth(level_type * level, int x_id, int rhs_id, double a, double b, int l1){
+  const int num_smooths = (level->num_smooths>0) ? level->num_smooths : JACOBI_NUM_SMOOTHS;
+  if(num_smooths&1){
+    fprintf(stderr,"error - JACOBI_NUM_SMOOTHS must be even...\n");
     exit(0);
   }
 
-  #ifdef USE_L1JACOBI
-  double weight = 1.0;
-  #else
-  double weight = 2.0/3.0;
-  #endif
+  double weight = l1 ? 1.0 : 2.0/3.0;
  
   int block,s;
-  for(s=0;s<NUM_SMOOTHS;s++){
+  for(s=0;s<num_smooths;s++){
     // exchange ghost zone data... Jacobi ping pongs between x_id and VECTOR_TEMP
     if((s&1)==0){exchange_boundary(level,       x_id,stencil_get_shape());apply_BCs(level,       x_id,stencil_get_shape());}
             else{exchange_boundary(level,VECTOR_TEMP,stencil_get_shape());apply_BCs(level,VECTOR_TEMP,stencil_get_shape());}
@@ -44,15 +42,23 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
       const int kStride = level->my_boxes[box].kStride;
       const double h2inv = 1.0/(level->h*level->h);
       const double * __restrict__ rhs    = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+      #ifdef USE_PACKED_COEFFICIENTS
+      const double * __restrict__ coefs  = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+      #else
+      #ifdef USE_HELMHOLTZ
       const double * __restrict__ alpha  = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+      #endif
       const double * __restrict__ beta_i = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
       const double * __restrict__ beta_j = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
       const double * __restrict__ beta_k = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ valid  = level->my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride); // cell is inside the domain
-      #ifdef USE_L1JACOBI
-      const double * __restrict__ lambda = level->my_boxes[box].vectors[VECTOR_L1INV ] + ghosts*(1+jStride+kStride);
-      #else
-      const double * __restrict__ lambda = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
+      #endif
+      #ifdef STENCIL_FUSE_BC
+      const valid_region_type valid      = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+      #endif
+      const double * __restrict__ lambda = level->my_boxes[box].vectors[l1 ? VECTOR_L1INV : VECTOR_DINV] + ghosts*(1+jStride+kStride);
+            int           lambda_stride = 1;
+      #ifdef USE_PACKED_COEFFICIENTS
+      if(!level->constant_coefficients){lambda = coefs + (l1 ? PACKED_L1INV : PACKED_DINV);lambda_stride = PACKED_COEFS;} // lambda[PACKED_COEFS*ijk]
       #endif
         const double * __restrict__ x_n;
               double * __restrict__ x_np1;
@@ -66,7 +72,7 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
       for(i=ilo;i<ihi;i++){
         int ijk = i + j*jStride + k*kStride;
         double Ax_n = apply_op_ijk(x_n);
-        x_np1[ijk] = x_n[ijk] + weight*lambda[ijk]*(rhs[ijk]-Ax_n);
+        x_np1[ijk] = x_n[ijk] + weight*lambda[lambda_stride*ijk]*(rhs[ijk]-Ax_n);
       }}}
 
     } // box-loop
@@ -75,4 +81,8 @@ void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
   } // s-loop
 }
 
+
+//------------------------------------------------------------------------------------------------------------------------------
+void smooth_jacobi(  level_type * level, int x_id, int rhs_id, double a, double b){jacobi_smooth(level,x_id,rhs_id,a,b,0);}
+void smooth_l1jacobi(level_type * level, int x_id, int rhs_id, double a, double b){jacobi_smooth(level,x_id,rhs_id,a,b,1);}
 //------------------------------------------------------------------------------------------------------------------------------
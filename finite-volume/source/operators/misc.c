@@ -27,13 +27,14 @@ void zero_vector(level_type * level, int id_a){
     const int  ghosts = level->my_boxes[box].ghosts;
     const int     dim = level->my_boxes[box].dim;
 
-    // expand the size of the block to include the ghost zones...
-    if(ilo<=  0)ilo-=ghosts; 
-    if(jlo<=  0)jlo-=ghosts; 
-    if(klo<=  0)klo-=ghosts; 
-    if(ihi>=dim)ihi+=ghosts; 
-    if(jhi>=dim)jhi+=ghosts; 
-    if(khi>=dim)khi+=ghosts; 
+    // expand the size of the block to include the ghost zones (but not those shared with other boxes of a brick)...
+    const int gid = level->my_boxes[box].global_box_id;
+    if( (ilo<=  0) && !ghost_zone_is_shared(level,gid,-1, 0, 0) )ilo-=ghosts; 
+    if( (jlo<=  0) && !ghost_zone_is_shared(level,gid, 0,-1, 0) )jlo-=ghosts; 
+    if( (klo<=  0) && !ghost_zone_is_shared(level,gid, 0, 0,-1) )klo-=ghosts; 
+    if( (ihi>=dim) && !ghost_zone_is_shared(level,gid, 1, 0, 0) )ihi+=ghosts; 
+    if( (jhi>=dim) && !ghost_zone_is_shared(level,gid, 0, 1, 0) )jhi+=ghosts; 
+    if( (khi>=dim) && !ghost_zone_is_shared(level,gid, 0, 0, 1) )khi+=ghosts; 
 
     double * __restrict__ grid = level->my_boxes[box].vectors[id_a] + ghosts*(1+jStride+kStride);
 
@@ -50,53 +51,27 @@ void zero_vector(level_type * level, int id_a){
 
 
 //------------------------------------------------------------------------------------------------------------------------------
+// describe which cells of each box (including its ghost zones) are inside the domain.
+// Rather than streaming a 0/1 mask, the operators test a neighbor's box-relative index against [valid.lo,valid.hi)
 void initialize_valid_region(level_type * level){
-  double _timeStart = getTime();
-  int block;
-
-  if(level->use_cuda)cudaDeviceSynchronize(); // FIX... no CUDA version... must sync CPU/GPU before using CPU version...
-
-  PRAGMA_THREAD_ACROSS_BLOCKS(level,block,level->num_my_blocks)
-  for(block=0;block<level->num_my_blocks;block++){
-    const int box = level->my_blocks[block].read.box;
-          int ilo = level->my_blocks[block].read.i; 
-          int jlo = level->my_blocks[block].read.j; 
-          int klo = level->my_blocks[block].read.k; 
-          int ihi = level->my_blocks[block].dim.i + ilo;
-          int jhi = level->my_blocks[block].dim.j + jlo;
-          int khi = level->my_blocks[block].dim.k + klo;
-    int i,j,k;
-    const int jStride = level->my_boxes[box].jStride;
-    const int kStride = level->my_boxes[box].kStride;
+  int box;
+  for(box=0;box<level->num_my_boxes;box++){
     const int  ghosts = level->my_boxes[box].ghosts;
     const int     dim = level->my_boxes[box].dim;
-
-    // expand the size of the block to include the ghost zones...
-    if(ilo<=  0)ilo-=ghosts; 
-    if(jlo<=  0)jlo-=ghosts; 
-    if(klo<=  0)klo-=ghosts; 
-    if(ihi>=dim)ihi+=ghosts; 
-    if(jhi>=dim)jhi+=ghosts; 
-    if(khi>=dim)khi+=ghosts; 
-
-    double * __restrict__ valid = level->my_boxes[box].vectors[VECTOR_VALID] + ghosts*(1+jStride+kStride);
-
-    for(k=klo;k<khi;k++){
-    for(j=jlo;j<jhi;j++){
-    for(i=ilo;i<ihi;i++){
-      int ijk = i + j*jStride + k*kStride;
-      valid[ijk] = 1.0; // i.e. all cells including ghosts are valid for periodic BC's
-      if(level->boundary_condition.type == BC_DIRICHLET){ // cells outside the domain boundaries are not valid
-        if(i + level->my_boxes[box].low.i <             0)valid[ijk] = 0.0;
-        if(j + level->my_boxes[box].low.j <             0)valid[ijk] = 0.0;
-        if(k + level->my_boxes[box].low.k <             0)valid[ijk] = 0.0;
-        if(i + level->my_boxes[box].low.i >= level->dim.i)valid[ijk] = 0.0;
-        if(j + level->my_boxes[box].low.j >= level->dim.j)valid[ijk] = 0.0;
-        if(k + level->my_boxes[box].low.k >= level->dim.k)valid[ijk] = 0.0;
-      }
-    }}}
+    valid_region_type valid;
+    if(level->boundary_condition.type == BC_DIRICHLET){ // cells outside the domain boundaries are not valid
+      valid.lo.i =              -level->my_boxes[box].low.i;
+      valid.lo.j =              -level->my_boxes[box].low.j;
+      valid.lo.k =              -level->my_boxes[box].low.k;
+      valid.hi.i = level->dim.i -level->my_boxes[box].low.i;
+      valid.hi.j = level->dim.j -level->my_boxes[box].low.j;
+      valid.hi.k = level->dim.k -level->my_boxes[box].low.k;
+    }else{ // i.e. all cells including ghosts are valid for periodic BC's
+      valid.lo.i = valid.lo.j = valid.lo.k =    -ghosts;
+      valid.hi.i = valid.hi.j = valid.hi.k = dim+ghosts;
+    }
+    level->my_boxes[box].valid = valid;
   }
-  level->timers.blas1 += (double)(getTime()-_timeStart);
 }
 
 
@@ -123,13 +98,14 @@ void init_vector(level_type * level, int id_a, double scalar){
     const int  ghosts = level->my_boxes[box].ghosts;
     const int     dim = level->my_boxes[box].dim;
 
-    // expand the size of the block to include the ghost zones...
-    if(ilo<=  0)ilo-=ghosts; 
-    if(jlo<=  0)jlo-=ghosts; 
-    if(klo<=  0)klo-=ghosts; 
-    if(ihi>=dim)ihi+=ghosts; 
-    if(jhi>=dim)jhi+=ghosts; 
-    if(khi>=dim)khi+=ghosts; 
+    // expand the size of the block to include the ghost zones (but not those shared with other boxes of a brick)...
+    const int gid = level->my_boxes[box].global_box_id;
+    if( (ilo<=  0) && !ghost_zone_is_shared(level,gid,-1, 0, 0) )ilo-=ghosts; 
+    if( (jlo<=  0) && !ghost_zone_is_shared(level,gid, 0,-1, 0) )jlo-=ghosts; 
+    if( (klo<=  0) && !ghost_zone_is_shared(level,gid, 0, 0,-1) )klo-=ghosts; 
+    if( (ihi>=dim) && !ghost_zone_is_shared(level,gid, 1, 0, 0) )ihi+=ghosts; 
+    if( (jhi>=dim) && !ghost_zone_is_shared(level,gid, 0, 1, 0) )jhi+=ghosts; 
+    if( (khi>=dim) && !ghost_zone_is_shared(level,gid, 0, 0, 1) )khi+=ghosts; 
 
     double * __restrict__ grid = level->my_boxes[box].vectors[id_a] + ghosts*(1+jStride+kStride);
 
@@ -597,7 +573,13 @@ void random_vector(level_type * level, int id_a){
     for(j=jlo;j<jhi;j++){
     for(i=ilo;i<ihi;i++){
       int ijk = i + j*jStride + k*kStride;
-      grid[ijk] = -1.000 + 2.0*(i^j^k^0x1);
+      // hash the global index of the cell so that the vector is independent of the decomposition and thread count...
+      uint64_t n = (uint64_t)(level->my_boxes[box].low.i+i) + (uint64_t)level->dim.i*( (uint64_t)(level->my_boxes[box].low.j+j) + (uint64_t)level->dim.j*(uint64_t)(level->my_boxes[box].low.k+k) );
+      n = (n+1)*0x9E3779B97F4A7C15ull;
+      n = (n^(n>>30))*0xBF58476D1CE4E5B9ull;
+      n = (n^(n>>27))*0x94D049BB133111EBull;
+      n =  n^(n>>31);
+      grid[ijk] = -1.000 + 2.0*(double)(n>>11)/9007199254740992.0; // uniform in [-1,1)
     }}}
   }
   level->timers.blas1 += (double)(getTime()-_timeStart);
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Interleaved operator coefficients (-DUSE_PACKED_COEFFICIENTS)
+// The variable-coefficient stencil would otherwise stream alpha, beta_i, beta_j, beta_k, and Dinv (or L1inv) as separate
+// arrays alongside x and rhs.  Here, each cell's coefficients are copied into one record of PACKED_COEFS doubles so that
+// the smoothers, residual, and apply_op read them as a single stream (see ALPHA(), BETA_I(), ... in the operator file).
+// The separate vectors remain the master copy (restriction, exchange, BCs, the bottom solvers, and GPU levels use them).
+// Thus, this must be called whenever they change (i.e. in rebuild_operator()).
+//------------------------------------------------------------------------------------------------------------------------------
+#ifdef USE_PACKED_COEFFICIENTS
+void pack_coefficients(level_type * level){
+  if(level->use_cuda)return; // the CUDA kernels read the separate vectors
+  if(level->constant_coefficients)return; // there are no coefficients to pack
+  uint64_t vector_volume = level->brick ? (uint64_t)level->box_volume : (uint64_t)level->num_my_boxes*level->box_volume;
+
+  // allocate once and point each box at its records (offset of the box within each vector times PACKED_COEFS)...
+  if(level->coefficients==NULL){
+    level->coefficients = (double*)um_malloc(PACKED_COEFS*vector_volume*sizeof(double), level->um_access_policy);
+    if((vector_volume>0)&&(level->coefficients==NULL)){fprintf(stderr,"malloc failed - pack_coefficients\n");exit(0);}
+    int box;
+    for(box=0;box<level->num_my_boxes;box++)level->my_boxes[box].coefficients = level->coefficients + PACKED_COEFS*(level->my_boxes[box].vectors[0]-level->vectors[0]);
+  }
+
+  // copy every element (including ghost zones) of each coefficient...
+  const double * __restrict__ alpha  = level->vectors[VECTOR_ALPHA ];
+  const double * __restrict__ beta_i = level->vectors[VECTOR_BETA_I];
+  const double * __restrict__ beta_j = level->vectors[VECTOR_BETA_J];
+  const double * __restrict__ beta_k = level->vectors[VECTOR_BETA_K];
+  const double * __restrict__ Dinv   = level->vectors[VECTOR_DINV  ];
+  const double * __restrict__ L1inv  = level->vectors[VECTOR_L1INV ];
+        double * __restrict__ coefs  = level->coefficients;
+  uint64_t ijk;
+  #ifdef _OPENMP
+  #pragma omp parallel for
+  #endif
+  for(ijk=0;ijk<vector_volume;ijk++){
+    coefs[PACKED_COEFS*ijk+PACKED_ALPHA ] =  alpha[ijk];
+    coefs[PACKED_COEFS*ijk+PACKED_BETA_I] = beta_i[ijk];
+    coefs[PACKED_COEFS*ijk+PACKED_BETA_J] = beta_j[ijk];
+    coefs[PACKED_COEFS*ijk+PACKED_BETA_K] = beta_k[ijk];
+    coefs[PACKED_COEFS*ijk+PACKED_DINV  ] =   Dinv[ijk];
+    coefs[PACKED_COEFS*ijk+PACKED_L1INV ] =  L1inv[ijk];
+  }
+}
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
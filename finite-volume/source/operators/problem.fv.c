@@ -6,7 +6,8 @@
 #ifndef M_PI
 #define M_PI 3.14159265358979323846 // in case math.h doesn't define it
 #endif
-double evaluateBeta(double x, double y, double z, double h, int add_Bxx, int add_Byy, int add_Bzz){
+// (x,y,z) are in [0,1]^3 and (hx,hy,hz) is the cell size in each of those dimensions
+double evaluateBeta(double x, double y, double z, double hx, double hy, double hz, int add_Bxx, int add_Byy, int add_Bzz){
   double b = 0.25;
   double a = 2.0*M_PI; // one period on [0,1]^3
 
@@ -19,15 +20,15 @@ double evaluateBeta(double x, double y, double z, double h, int add_Bxx, int add
   double Bzz   = -a*a*b*sin(a*x)*sin(a*y)*sin(a*z);
 
   // 4th order correction to approximate the conversion of cell-centered values to cell-averaged...
-  if(add_Bxx)B+=(h*h/24.0)*Bxx;
-  if(add_Byy)B+=(h*h/24.0)*Byy;
-  if(add_Bzz)B+=(h*h/24.0)*Bzz;
+  if(add_Bxx)B+=(hx*hx/24.0)*Bxx;
+  if(add_Byy)B+=(hy*hy/24.0)*Byy;
+  if(add_Bzz)B+=(hz*hz/24.0)*Bzz;
   return(B);
 }
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-double evaluateF(double x, double y, double z, double h, int add_Fxx, int add_Fyy, int add_Fzz){
+double evaluateF(double x, double y, double z, double hx, double hy, double hz, int add_Fxx, int add_Fyy, int add_Fzz){
   #if 0 // harder problem... not sure I manually differentiated this right...
   // 8 'poles', one per octant
   double    cx = 0.75;
@@ -78,9 +79,9 @@ double evaluateF(double x, double y, double z, double h, int add_Fxx, int add_Fy
   #endif
 
   // 4th order correction to approximate the conversion of cell-centered values to cell-averaged...
-  if(add_Fxx)F+=(h*h/24.0)*Fxx;
-  if(add_Fyy)F+=(h*h/24.0)*Fyy;
-  if(add_Fzz)F+=(h*h/24.0)*Fzz;
+  if(add_Fxx)F+=(hx*hx/24.0)*Fxx;
+  if(add_Fyy)F+=(hy*hy/24.0)*Fyy;
+  if(add_Fzz)F+=(hz*hz/24.0)*Fzz;
 
   return(F);
 }
@@ -90,6 +91,11 @@ double evaluateF(double x, double y, double z, double h, int add_Fxx, int add_Fy
 void initialize_problem(level_type * level, double hLevel, double a, double b){
   level->h = hLevel;
 
+  // the problem is defined on [0,1]^3 with hLevel=1/dim.i.  On a rectangular domain it is stretched in j and k (cells remain cubic)...
+  const double hi = hLevel;
+  const double hj = hLevel*( (double)level->dim.i/(double)level->dim.j );
+  const double hk = hLevel*( (double)level->dim.i/(double)level->dim.k );
+
   int box;
   for(box=0;box<level->num_my_boxes;box++){
     int i,j,k;
@@ -107,9 +113,9 @@ void initialize_problem(level_type * level, double hLevel, double a, double b){
     for(i=0;i<=dim_i;i++){ // include high face
       //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
       int ijk = (i+ghosts) + (j+ghosts)*jStride + (k+ghosts)*kStride;
-      double x = hLevel*( (double)(i+level->my_boxes[box].low.i) + 0.5 ); // +0.5 to get to the center of cell
-      double y = hLevel*( (double)(j+level->my_boxes[box].low.j) + 0.5 );
-      double z = hLevel*( (double)(k+level->my_boxes[box].low.k) + 0.5 );
+      double x = hi*( (double)(i+level->my_boxes[box].low.i) + 0.5 ); // +0.5 to get to the center of cell
+      double y = hj*( (double)(j+level->my_boxes[box].low.j) + 0.5 );
+      double z = hk*( (double)(k+level->my_boxes[box].low.k) + 0.5 );
       double A,Bi,Bj,Bk;
       //double A,B,Bx,By,Bz,Bi,Bj,Bk;
       //double U,Ux,Uy,Uz,Uxx,Uyy,Uzz;
@@ -119,12 +125,12 @@ void initialize_problem(level_type * level, double hLevel, double a, double b){
       Bj = 1.0;
       Bk = 1.0;
       #ifdef STENCIL_VARIABLE_COEFFICIENT // variable coefficient problem...
-      Bi=evaluateBeta(x-hLevel*0.5,y           ,z           ,hLevel,0,1,1); // face-centered value of Beta for beta_i
-      Bj=evaluateBeta(x           ,y-hLevel*0.5,z           ,hLevel,1,0,1); // face-centered value of Beta for beta_j
-      Bk=evaluateBeta(x           ,y           ,z-hLevel*0.5,hLevel,1,1,0); // face-centered value of Beta for beta_k
+      Bi=evaluateBeta(x-hi*0.5,y       ,z       ,hi,hj,hk,0,1,1); // face-centered value of Beta for beta_i
+      Bj=evaluateBeta(x       ,y-hj*0.5,z       ,hi,hj,hk,1,0,1); // face-centered value of Beta for beta_j
+      Bk=evaluateBeta(x       ,y       ,z-hk*0.5,hi,hj,hk,1,1,0); // face-centered value of Beta for beta_k
       #endif
       //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-      double F=evaluateF(x,y,z,hLevel,1,1,1);
+      double F=evaluateF(x,y,z,hi,hj,hk,1,1,1);
       //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
       level->my_boxes[box].vectors[VECTOR_BETA_I][ijk] = Bi;
       level->my_boxes[box].vectors[VECTOR_BETA_J][ijk] = Bj;
@@ -79,6 +79,10 @@ void evaluateU(double x, double y, double z, double *U, double *Ux, double *Uy,
 void initialize_problem(level_type * level, double hLevel, double a, double b){
   level->h = hLevel;
 
+  // U is defined on [0,1]^3 with hLevel=1/dim.i.  On a rectangular domain it is stretched (by 1/sj and 1/sk) in j and k...
+  const double sj = (double)level->dim.i/(double)level->dim.j;
+  const double sk = (double)level->dim.i/(double)level->dim.k;
+
   int box;
   if(level->use_cuda)cudaDeviceSynchronize(); // FIX... wait for GPU before initializing any data
 
@@ -119,7 +123,9 @@ void initialize_problem(level_type * level, double hLevel, double a, double b){
       evaluateBeta(x           ,y           ,z           ,&B ,&Bx,&By,&Bz); // cell-centered value of Beta
       #endif
       //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-      evaluateU(x,y,z,&U,&Ux,&Uy,&Uz,&Uxx,&Uyy,&Uzz, (level->boundary_condition.type == BC_PERIODIC) );
+      evaluateU(x,y*sj,z*sk,&U,&Ux,&Uy,&Uz,&Uxx,&Uyy,&Uzz, (level->boundary_condition.type == BC_PERIODIC) );
+      Uy*=sj;Uyy*=sj*sj; // chain rule for the stretched dimensions
+      Uz*=sk;Uzz*=sk*sk;
       double F = a*A*U - b*( (Bx*Ux + By*Uy + Bz*Uz)  +  B*(Uxx + Uyy + Uzz) );
       //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
       level->my_boxes[box].vectors[VECTOR_BETA_I][ijk] = Bi;
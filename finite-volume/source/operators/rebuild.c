@@ -43,8 +43,46 @@ double power_method(level_type * level, double a, double b, int max_iterations){
 // colors_in_each_dim should be sufficiently large as to decouple the boundary condition from the operator
 // e.g. with quartic BC's, colors_in_each_dim==4 (total of 64 colors in 3D)
 // If using periodic BCs, one should be able to set colors_in_each_dim to stencil_get_radius();
-// NOTE, as this function is not timed, it has not been optimized for performance.
+// On the host...
+//  - the colored vector (including its ghost zones) is computed from global coordinates and thus requires no ghost zone exchanges
+//  - if the operator defines Aii_ijk() and sumAbsAij_ijk() (STENCIL_ANALYTIC_COLORS), rows whose stencil does not reach a
+//    (non-periodic) domain boundary are calculated directly from alpha/beta and only boundary-adjacent cells are probed
+// The time spent here is accumulated in level->timers.rebuild_operator
+//------------------------------------------------------------------------------------------------------------------------------
+// set x (including ghost zones) to 1.0 on cells of the specified color (as color_vector() followed by exchange_boundary() would)
+// only boxes with probe[box]!=0 are colored
+void color_vector_with_ghosts(level_type * level, int x_id, int colors_in_each_dim, int icolor, int jcolor, int kcolor, const char *probe){
+  const int periodic = (level->boundary_condition.type == BC_PERIODIC);
+  const int C = colors_in_each_dim;
+  int box;
+  #ifdef _OPENMP
+  #pragma omp parallel for private(box) if(!level->brick) // boxes of a brick share their ghost zones
+  #endif
+  for(box=0;box<level->num_my_boxes;box++)if(probe[box]){
+    const int jStride = level->my_boxes[box].jStride;
+    const int kStride = level->my_boxes[box].kStride;
+    const int  ghosts = level->my_boxes[box].ghosts;
+    const int     dim = level->my_boxes[box].dim;
+    double * __restrict__ x = level->my_boxes[box].vectors[x_id] + ghosts*(1+jStride+kStride);
+    double s[3][dim+2*ghosts]; // s[d][ghosts+i] = 1.0 if cell i of this box (in dimension d) is of the specified color
+    int i,j,k;
+    for(i=-ghosts;i<dim+ghosts;i++){
+      int gi=i+level->my_boxes[box].low.i;if(periodic)gi=(gi+level->dim.i)%level->dim.i;s[0][ghosts+i]=( ((gi%C)+C+icolor)%C == 0 ) ? 1.0 : 0.0;
+      int gj=i+level->my_boxes[box].low.j;if(periodic)gj=(gj+level->dim.j)%level->dim.j;s[1][ghosts+i]=( ((gj%C)+C+jcolor)%C == 0 ) ? 1.0 : 0.0;
+      int gk=i+level->my_boxes[box].low.k;if(periodic)gk=(gk+level->dim.k)%level->dim.k;s[2][ghosts+i]=( ((gk%C)+C+kcolor)%C == 0 ) ? 1.0 : 0.0;
+    }
+    for(k=-ghosts;k<dim+ghosts;k++){
+    for(j=-ghosts;j<dim+ghosts;j++){const double sjk = s[1][ghosts+j]*s[2][ghosts+k];
+    for(i=-ghosts;i<dim+ghosts;i++){
+      x[i + j*jStride + k*kStride] = s[0][ghosts+i]*sjk;
+    }}}
+  }
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------
 void rebuild_operator_blackbox(level_type * level, double a, double b, int colors_in_each_dim){
+  double _timeStartRebuild = getTime();
 
   // trying to color a 1^3 grid with 8 colors won't work... reduce the number of colors...
   if(level->dim.i<colors_in_each_dim)colors_in_each_dim=level->dim.i;
@@ -84,6 +122,7 @@ void rebuild_operator_blackbox(level_type * level, double a, double b, int color
   zero_vector(level,      Aii_id);
   zero_vector(level,sumAbsAij_id);
 
+  if(level->use_cuda){
   // loop over all colors...
   for(kcolor=0;kcolor<colors_in_each_dim;kcolor++){
   for(jcolor=0;jcolor<colors_in_each_dim;jcolor++){
@@ -96,10 +135,37 @@ void rebuild_operator_blackbox(level_type * level, double a, double b, int color
             apply_BCs(level,x_id,stencil_get_shape());
 
     // apply the operator and add to Aii and AbsAij 
-    if (level->use_cuda) {
-      cuda_rebuild(*level, x_id, Aii_id, sumAbsAij_id, a, b);
-    }
-    else {
+    cuda_rebuild(*level, x_id, Aii_id, sumAbsAij_id, a, b);
+  }}}
+
+  // make sure GPU kernels have finished since the following part runs on CPU
+  cudaDeviceSynchronize();
+  }else{
+
+  // cells within radius (r) of a non-periodic domain boundary must be probed.  Without analytic rows, every cell is probed
+  const int periodic = (level->boundary_condition.type == BC_PERIODIC);
+  int analytic = 0;
+  #if defined(Aii_ijk) && defined(sumAbsAij_ijk)
+  analytic = (colors_in_each_dim == STENCIL_ANALYTIC_COLORS) && ((level->dim.i%colors_in_each_dim)==0) && ((level->dim.j%colors_in_each_dim)==0) && ((level->dim.k%colors_in_each_dim)==0);
+  #endif
+  int r = periodic ? 0 : stencil_get_radius();
+  if(!analytic)r = level->dim.i+level->dim.j+level->dim.k;
+
+  // boxes with at least one cell to probe...
+  int box,num_probe_boxes=0;
+  char *probe = (char*)malloc(level->num_my_boxes*sizeof(char)+1);
+  if(probe==NULL){fprintf(stderr,"malloc failed - rebuild_operator_blackbox\n");exit(0);}
+  for(box=0;box<level->num_my_boxes;box++){
+    const int dim = level->my_boxes[box].dim;
+    probe[box] = (level->my_boxes[box].low.i<r) || (level->my_boxes[box].low.i+dim>level->dim.i-r) ||
+                 (level->my_boxes[box].low.j<r) || (level->my_boxes[box].low.j+dim>level->dim.j-r) ||
+                 (level->my_boxes[box].low.k<r) || (level->my_boxes[box].low.k+dim>level->dim.k-r);
+    num_probe_boxes+=probe[box];
+  }
+
+  // rows which do not touch the boundary...
+  #if defined(Aii_ijk) && defined(sumAbsAij_ijk)
+  if(analytic){
     PRAGMA_THREAD_ACROSS_BLOCKS(level,block,level->num_my_blocks)
     for(block=0;block<level->num_my_blocks;block++){
       const int box = level->my_blocks[block].read.box;
@@ -113,29 +179,93 @@ void rebuild_operator_blackbox(level_type * level, double a, double b, int color
       const int kStride = level->my_boxes[box].kStride;
       const int  ghosts = level->my_boxes[box].ghosts;
       const double h2inv = 1.0/(level->h*level->h);
-      const double * __restrict__         x = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
+      #ifdef USE_PACKED_COEFFICIENTS
+      const double * __restrict__     coefs = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+      #else
+      #ifdef USE_HELMHOLTZ
       const double * __restrict__     alpha = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+      #endif
       const double * __restrict__    beta_i = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
       const double * __restrict__    beta_j = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
       const double * __restrict__    beta_k = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+      #endif
             double * __restrict__       Aii = level->my_boxes[box].vectors[       Aii_id] + ghosts*(1+jStride+kStride);
             double * __restrict__ sumAbsAij = level->my_boxes[box].vectors[ sumAbsAij_id] + ghosts*(1+jStride+kStride);
-  
+      const int i0 = (r-level->my_boxes[box].low.i > ilo) ? r-level->my_boxes[box].low.i : ilo; // [i0,i1) are not within r of an i boundary
+      const int i1 = (level->dim.i-r-level->my_boxes[box].low.i < ihi) ? level->dim.i-r-level->my_boxes[box].low.i : ihi;
+
       int i,j,k;
-      for(k=klo;k<khi;k++){
-      for(j=jlo;j<jhi;j++){
-      for(i=ilo;i<ihi;i++){
+      for(k=klo;k<khi;k++){if( (k+level->my_boxes[box].low.k<r) || (k+level->my_boxes[box].low.k>=level->dim.k-r) )continue;
+      for(j=jlo;j<jhi;j++){if( (j+level->my_boxes[box].low.j<r) || (j+level->my_boxes[box].low.j>=level->dim.j-r) )continue;
+      for(i=i0;i<i1;i++){
         int ijk = i + j*jStride + k*kStride;
-        double Ax = apply_op_ijk(x);
-              Aii[ijk] +=      (    x[ijk])*Ax; // add the effect of setting one grid point (i) to 1.0 to Aii
-        sumAbsAij[ijk] += fabs((1.0-x[ijk])*Ax);
+              Aii[ijk] =       Aii_ijk();
+        sumAbsAij[ijk] = sumAbsAij_ijk();
       }}}
     }
+  }
+  #endif
+
+  // probe the rows which touch the boundary with each color...
+  if(num_probe_boxes>0)
+  for(kcolor=0;kcolor<colors_in_each_dim;kcolor++){
+  for(jcolor=0;jcolor<colors_in_each_dim;jcolor++){
+  for(icolor=0;icolor<colors_in_each_dim;icolor++){
+    // color the grid (including ghost zones) as 1's and 0's
+    color_vector_with_ghosts(level,x_id,colors_in_each_dim,icolor,jcolor,kcolor,probe);
+                   apply_BCs(level,x_id,stencil_get_shape());
+
+    // apply the operator and add to Aii and AbsAij 
+    PRAGMA_THREAD_ACROSS_BLOCKS(level,block,level->num_my_blocks)
+    for(block=0;block<level->num_my_blocks;block++)if(probe[level->my_blocks[block].read.box]){
+      const int box = level->my_blocks[block].read.box;
+      const int ilo = level->my_blocks[block].read.i;
+      const int jlo = level->my_blocks[block].read.j;
+      const int klo = level->my_blocks[block].read.k;
+      const int ihi = level->my_blocks[block].dim.i + ilo;
+      const int jhi = level->my_blocks[block].dim.j + jlo;
+      const int khi = level->my_blocks[block].dim.k + klo;
+      const int jStride = level->my_boxes[box].jStride;
+      const int kStride = level->my_boxes[box].kStride;
+      const int  ghosts = level->my_boxes[box].ghosts;
+      const double h2inv = 1.0/(level->h*level->h);
+      const double * __restrict__         x = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
+      #ifdef USE_PACKED_COEFFICIENTS
+      const double * __restrict__     coefs = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+      #else
+      #ifdef USE_HELMHOLTZ
+      const double * __restrict__     alpha = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+      #endif
+      const double * __restrict__    beta_i = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
+      const double * __restrict__    beta_j = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
+      const double * __restrict__    beta_k = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+      #endif
+            double * __restrict__       Aii = level->my_boxes[box].vectors[       Aii_id] + ghosts*(1+jStride+kStride);
+            double * __restrict__ sumAbsAij = level->my_boxes[box].vectors[ sumAbsAij_id] + ghosts*(1+jStride+kStride);
+      const int i0 = (r-level->my_boxes[box].low.i > ilo) ? r-level->my_boxes[box].low.i : ilo; // [i0,i1) are not within r of an i boundary
+      const int i1 = (level->dim.i-r-level->my_boxes[box].low.i < ihi) ? level->dim.i-r-level->my_boxes[box].low.i : ihi;
+
+      int i,j,k;
+      for(k=klo;k<khi;k++){const int kin = (k+level->my_boxes[box].low.k>=r) && (k+level->my_boxes[box].low.k<level->dim.k-r);
+      for(j=jlo;j<jhi;j++){const int jin = (j+level->my_boxes[box].low.j>=r) && (j+level->my_boxes[box].low.j<level->dim.j-r);
+        // probe [ilo,i0) and [i1,ihi) if the pencil is interior in j and k... i.e. skip the cells which were calculated analytically
+        const int skip = jin && kin && (i0<i1);
+        int s;
+        for(s=0;s<2;s++){
+          const int is = (s==0) ? ilo : (skip ? i1 : ihi);
+          const int ie = (s==0) ? (skip ? i0 : ihi) : ihi;
+          for(i=is;i<ie;i++){
+            int ijk = i + j*jStride + k*kStride;
+            double Ax = apply_op_ijk(x);
+                  Aii[ijk] +=      (    x[ijk])*Ax; // add the effect of setting one grid point (i) to 1.0 to Aii
+            sumAbsAij[ijk] += fabs((1.0-x[ijk])*Ax);
+          }
+        }
+      }}
     }
   }}}
-
-  // make sure GPU kernels have finished since the following part runs on CPU
-  cudaDeviceSynchronize();
+  free(probe);
+  }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // take Aii and the row sum sumAbsAij and calculate D^{-1} and L1^{-1}...
@@ -205,5 +335,6 @@ void rebuild_operator_blackbox(level_type * level, double a, double b, int color
   //level->dominant_eigenvalue_of_DinvA = power_method(level,a,b,10);
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   #endif
+  level->timers.rebuild_operator += (double)(getTime()-_timeStartRebuild);
 }
 //------------------------------------------------------------------------------------------------------------------------------
@@ -6,12 +6,8 @@
 // This routines calculates the residual (res=rhs-Ax) using the linear operator specified in the apply_op_ijk macro
 // This requires exchanging a ghost zone and/or enforcing a boundary condition.
 // NOTE, x_id must be distinct from rhs_id and res_id
-void residual(level_type * level, int res_id, int x_id, int rhs_id, double a, double b){
-  // exchange the boundary for x in prep for Ax...
-  exchange_boundary(level,x_id,stencil_get_shape());
-          apply_BCs(level,x_id,stencil_get_shape());
-
-  // now do residual/restriction proper...
+// residual_blocks() assumes the ghost zones of x are valid
+void residual_blocks(level_type * level, int res_id, int x_id, int rhs_id, double a, double b){
   double _timeStart = getTime();
   int block;
 
@@ -35,11 +31,19 @@ void residual(level_type * level, int res_id, int x_id, int rhs_id, double a, do
     const double h2inv = 1.0/(level->h*level->h);
     const double * __restrict__ x      = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
     const double * __restrict__ rhs    = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+    #ifdef USE_PACKED_COEFFICIENTS
+    const double * __restrict__ coefs  = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+    #else
+    #ifdef USE_HELMHOLTZ
     const double * __restrict__ alpha  = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+    #endif
     const double * __restrict__ beta_i = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
     const double * __restrict__ beta_j = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
     const double * __restrict__ beta_k = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
-    const double * __restrict__ valid  = level->my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride); // cell is inside the domain
+    #endif
+    #ifdef STENCIL_FUSE_BC
+    const valid_region_type valid      = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+    #endif
           double * __restrict__ res    = level->my_boxes[box].vectors[       res_id] + ghosts*(1+jStride+kStride);
 
     for(k=klo;k<khi;k++){
@@ -54,3 +58,13 @@ void residual(level_type * level, int res_id, int x_id, int rhs_id, double a, do
   level->timers.residual += (double)(getTime()-_timeStart);
 }
 
+
+void residual(level_type * level, int res_id, int x_id, int rhs_id, double a, double b){
+  // exchange the boundary for x in prep for Ax...
+  exchange_boundary(level,x_id,stencil_get_shape());
+          apply_BCs(level,x_id,stencil_get_shape());
+
+  // now do residual/restriction proper...
+  residual_blocks(level,res_id,x_id,rhs_id,a,b);
+}
+
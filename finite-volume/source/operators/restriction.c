@@ -129,25 +129,42 @@ void restriction(level_type * level_c, int id_c, level_type *level_f, int id_f,
 
 
   // pack MPI send buffers...
-  if(level_f->restriction[restrictionType].num_blocks[0]>0){
+  if( (level_f->restriction[restrictionType].num_blocks[0]>0) && level_f->use_cuda ){
     _timeStart = getTime();
-    if(level_f->use_cuda) {
-      cuda_restriction(*level_c,id_c,*level_f,id_f,level_f->restriction[restrictionType],restrictionType,0);
-      cudaDeviceSynchronize(); // synchronize so the CPU sees the updated buffers which will be used for MPI transfers
-    }
-    else {
-    PRAGMA_THREAD_ACROSS_BLOCKS(level_f,buffer,level_f->restriction[restrictionType].num_blocks[0])
-    for(buffer=0;buffer<level_f->restriction[restrictionType].num_blocks[0];buffer++){
-      restriction_pc_block(level_c,id_c,level_f,id_f,&level_f->restriction[restrictionType].blocks[0][buffer],restrictionType);
-    }
-    }
+    cuda_restriction(*level_c,id_c,*level_f,id_f,level_f->restriction[restrictionType],restrictionType,0);
+    cudaDeviceSynchronize(); // synchronize so the CPU sees the updated buffers which will be used for MPI transfers
     _timeEnd = getTime();
     level_f->timers.restriction_pack += (_timeEnd-_timeStart);
   }
 
- 
+
+  // on the host, pack each MPI send buffer and post its Isend before packing the next...
+  if( (level_f->restriction[restrictionType].num_sends>0) && !level_f->use_cuda ){
+    for(n=0;n<level_f->restriction[restrictionType].num_sends;n++){
+      int b0 = level_f->restriction[restrictionType].pack_start[n  ];
+      int b1 = level_f->restriction[restrictionType].pack_start[n+1];
+      _timeStart = getTime();
+      PRAGMA_THREAD_ACROSS_BLOCKS(level_f,buffer,b1-b0)
+      for(buffer=b0;buffer<b1;buffer++){
+        restriction_pc_block(level_c,id_c,level_f,id_f,&level_f->restriction[restrictionType].blocks[0][buffer],restrictionType);
+      }
+      _timeEnd = getTime();
+      MPI_Isend(level_f->restriction[restrictionType].send_buffers[n],
+                level_f->restriction[restrictionType].send_sizes[n],
+                MPI_DOUBLE,
+                level_f->restriction[restrictionType].send_ranks[n],
+                my_tag,
+                MPI_COMM_WORLD,
+                &send_requests[n]
+      );
+      level_f->timers.restriction_pack += (_timeEnd-_timeStart);
+      level_f->timers.restriction_send += (getTime()-_timeEnd);
+    }
+  }
+
+
   // loop through MPI send buffers and post Isend's...
-  if(level_f->restriction[restrictionType].num_sends>0){
+  if( (level_f->restriction[restrictionType].num_sends>0) && level_f->use_cuda ){
     _timeStart = getTime();
     #ifdef USE_MPI_THREAD_MULTIPLE
     #pragma omp parallel for schedule(dynamic,1)
@@ -165,6 +182,13 @@ void restriction(level_type * level_c, int id_c, level_type *level_f, int id_f,
     _timeEnd = getTime();
     level_f->timers.restriction_send += (_timeEnd-_timeStart);
   }
+
+  // let the communication thread wait on the messages and unpack them while the local restrictions are performed...
+  #ifdef USE_COMM_THREAD
+  comm_job_type job = {level_c,id_c,0,NULL,1.0,&level_c->restriction[restrictionType],nMessages,level_f->restriction[restrictionType].requests,level_f->restriction[restrictionType].status,0.0,0.0};
+  int use_comm_thread = (nMessages>0) && (!level_f->use_cuda) && (!level_c->use_cuda);
+  if(use_comm_thread)comm_thread_post(&job);
+  #endif
   #endif
 
 
@@ -188,6 +212,23 @@ void restriction(level_type * level_c, int id_c, level_type *level_f, int id_f,
 
   // wait for MPI to finish...
   #ifdef USE_MPI 
+  #ifdef USE_COMM_THREAD
+  if(use_comm_thread){
+    comm_thread_wait(&job);
+    level_f->timers.restriction_wait   += job.time_wait;
+    level_f->timers.restriction_unpack += job.time_unpack;
+  }else
+  #endif
+  if(!level_c->use_cuda){
+  // unpack each MPI receive buffer as soon as it arrives and then complete the sends...
+  if(nMessages){
+    unpack_in_arrival_order(level_c,id_c,0,NULL,1.0,&level_c->restriction[restrictionType],recv_requests,level_f->restriction[restrictionType].status,1,&level_f->timers.restriction_wait,&level_f->timers.restriction_unpack);
+    _timeStart = getTime();
+    MPI_Waitall(level_f->restriction[restrictionType].num_sends,send_requests,level_f->restriction[restrictionType].status);
+    _timeEnd = getTime();
+    level_f->timers.restriction_wait += (_timeEnd-_timeStart);
+  }
+  }else{
   if(nMessages){
     _timeStart = getTime();
     MPI_Waitall(nMessages,level_f->restriction[restrictionType].requests,level_f->restriction[restrictionType].status);
@@ -203,18 +244,11 @@ void restriction(level_type * level_c, int id_c, level_type *level_f, int id_f,
   // unpack MPI receive buffers 
   if(level_c->restriction[restrictionType].num_blocks[2]>0){
     _timeStart = getTime();
-    if(level_c->use_cuda) {
-      cuda_copy_block(*level_c,id_c,level_c->restriction[restrictionType],2);
-    }
-    else {
-    PRAGMA_THREAD_ACROSS_BLOCKS(level_f,buffer,level_c->restriction[restrictionType].num_blocks[2])
-    for(buffer=0;buffer<level_c->restriction[restrictionType].num_blocks[2];buffer++){
-      CopyBlock(level_c,id_c,&level_c->restriction[restrictionType].blocks[2][buffer]);
-    }
-    }
+    cuda_copy_block(*level_c,id_c,level_c->restriction[restrictionType],2);
     _timeEnd = getTime();
     level_f->timers.restriction_unpack += (_timeEnd-_timeStart);
   }
+  }
   #endif
  
  
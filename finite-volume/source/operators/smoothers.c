@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// All smoothers are compiled in and selected at runtime on a per-level basis (level->smoother).
+// The including operator file provides apply_op_ijk()/Dinv_ijk() and may override the number of smooths of each smoother.
+// -DUSE_GSRB, -DUSE_CHEBY, -DUSE_JACOBI, -DUSE_L1JACOBI, or -DUSE_SYMGS now only select the default smoother.
+// NOTE, the CUDA kernels still implement only the smoother selected at compile time.  GPU levels are therefore restricted to it.
+//------------------------------------------------------------------------------------------------------------------------------
+#ifndef GSRB_NUM_SMOOTHS
+#define GSRB_NUM_SMOOTHS      3 // RBRBRB
+#endif
+#ifndef CHEBYSHEV_NUM_SMOOTHS
+#define CHEBYSHEV_NUM_SMOOTHS 1
+#endif
+#ifndef CHEBYSHEV_DEGREE
+#define CHEBYSHEV_DEGREE      6 // i.e. one degree-6 polynomial smoother
+#endif
+#ifndef JACOBI_NUM_SMOOTHS
+#define JACOBI_NUM_SMOOTHS    6
+#endif
+#ifndef SYMGS_NUM_SMOOTHS
+#define SYMGS_NUM_SMOOTHS     2 // FBFB
+#endif
+#ifndef ZLINE_NUM_SMOOTHS
+#define ZLINE_NUM_SMOOTHS     1 // FB
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
+#include "gsrb.c"
+#include "chebyshev.c"
+#include "jacobi.c"
+#include "symgs.c"
+#include "zline.c"
+//------------------------------------------------------------------------------------------------------------------------------
+// dispatch table indexed by SMOOTHER_*
+struct {
+  const char *name;
+  void (*smooth)(level_type * level, int x_id, int rhs_id, double a, double b);
+} smoothers[NUM_SMOOTHERS] = {
+  {"gsrb"    ,smooth_gsrb     }, // SMOOTHER_GSRB
+  {"cheby"   ,smooth_chebyshev}, // SMOOTHER_CHEBY
+  {"jacobi"  ,smooth_jacobi   }, // SMOOTHER_JACOBI
+  {"l1jacobi",smooth_l1jacobi }, // SMOOTHER_L1JACOBI
+  {"symgs"   ,smooth_symgs    }, // SMOOTHER_SYMGS
+  {"zline"   ,smooth_zline    }, // SMOOTHER_ZLINE
+};
+
+
+// smoother selected at compile time (and implemented by the CUDA kernels)
+int smoother_get_default(){
+  #if   defined(USE_CHEBY)
+  return(SMOOTHER_CHEBY);
+  #elif defined(USE_JACOBI)
+  return(SMOOTHER_JACOBI);
+  #elif defined(USE_L1JACOBI)
+  return(SMOOTHER_L1JACOBI);
+  #elif defined(USE_SYMGS)
+  return(SMOOTHER_SYMGS);
+  #else
+  return(SMOOTHER_GSRB);
+  #endif
+}
+
+
+// returns -1 if the name is not recognized
+int smoother_get_id(const char *name){
+  int s;
+  for(s=0;s<NUM_SMOOTHERS;s++)if(strcmp(name,smoothers[s].name)==0)return(s);
+  return(-1);
+}
+
+
+const char * smoother_get_name(int smoother){
+  if( (smoother<0) || (smoother>=NUM_SMOOTHERS) )return("unknown");
+  return(smoothers[smoother].name);
+}
+
+
+void smooth(level_type * level, int x_id, int rhs_id, double a, double b){
+  smoothers[level->smoother].smooth(level,x_id,rhs_id,a,b);
+}
+//------------------------------------------------------------------------------------------------------------------------------
@@ -3,53 +3,146 @@
 // SWWilliams@lbl.gov
 // Lawrence Berkeley National Lab
 //------------------------------------------------------------------------------------------------------------------------------
-void smooth(level_type * level, int phi_id, int rhs_id, double a, double b){
-  int box,s;
+#if defined(SYMGS_WAVEFRONT)
+  #warning Overriding default SymGS implementation and threading the sweeps of each box across wavefronts of i-lines...
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
+// With -DSYMGS_WAVEFRONT, the i-lines (j,k) of each box are relaxed in wavefronts w = j + (radius+1)*k rather than lexicographically.
+// Every line that a line's stencil reaches and which precedes (follows) it lexicographically lies on an earlier (later) wavefront, and no two lines
+// of a wavefront reach each other.  Thus, the lines of a wavefront may be relaxed concurrently (each with a unit-stride sweep in i) and the
+// result is identical to that of the lexicographic sweep.  The backward sweep visits the wavefronts and the cells of each line in reverse.
+// Wavefronts are only used for bricks and for levels with fewer boxes than threads (e.g. one large box per process).
+void symgs_line(level_type * level, int phi_id, int rhs_id, double a, double b, int box, int j, int k, int forward){
+  int i;
+  const double h2inv = 1.0/(level->h*level->h);
+  const int ghosts =  level->box_ghosts;
+  const int jStride = level->my_boxes[box].jStride;
+  const int kStride = level->my_boxes[box].kStride;
+  const int     dim = level->my_boxes[box].dim;
+        double * __restrict__ phi      = level->my_boxes[box].vectors[       phi_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
+  const double * __restrict__ rhs      = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+  #ifdef USE_PACKED_COEFFICIENTS
+  const double * __restrict__ coefs    = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+  #else
+  #ifdef USE_HELMHOLTZ
+  const double * __restrict__ alpha    = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+  #endif
+  const double * __restrict__ beta_i   = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
+  const double * __restrict__ beta_j   = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
+  const double * __restrict__ beta_k   = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+  #endif
+  const double * __restrict__ Dinv     = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
+  #ifdef STENCIL_FUSE_BC
+  const valid_region_type valid        = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+  #endif
+
+  if(forward){
+    for(i=0;i<dim;i++){
+      int ijk = i + j*jStride + k*kStride;
+      double Ax = apply_op_ijk(phi);
+      phi[ijk] = phi[ijk] + Dinv_ijk()*(rhs[ijk]-Ax);
+    }
+  }else{
+    for(i=dim-1;i>=0;i--){
+      int ijk = i + j*jStride + k*kStride;
+      double Ax = apply_op_ijk(phi);
+      phi[ijk] = phi[ijk] + Dinv_ijk()*(rhs[ijk]-Ax);
+    }
+  }
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+void smooth_symgs(level_type * level, int phi_id, int rhs_id, double a, double b){
+  int s;
+  const int num_smooths = (level->num_smooths>0) ? level->num_smooths : SYMGS_NUM_SMOOTHS;
 
-  for(s=0;s<2*NUM_SMOOTHS;s++){ // there are two sweeps (forward/backward) per GS smooth
+  for(s=0;s<2*num_smooths;s++){ // there are two sweeps (forward/backward) per GS smooth
     exchange_boundary(level,phi_id,stencil_get_shape());
             apply_BCs(level,phi_id,stencil_get_shape());
 
     double _timeStart = getTime();
-    #ifdef _OPENMP
-    #pragma omp parallel for private(box)
-    #endif
-    for(box=0;box<level->num_my_boxes;box++){
-      int i,j,k;
-      const int ghosts = level->box_ghosts;
-      const int jStride = level->my_boxes[box].jStride;
-      const int kStride = level->my_boxes[box].kStride;
-      const int     dim = level->my_boxes[box].dim;
-      const double h2inv = 1.0/(level->h*level->h);
-            double * __restrict__ phi      = level->my_boxes[box].vectors[       phi_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
-      const double * __restrict__ rhs      = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ alpha    = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ beta_i   = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ beta_j   = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ beta_k   = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ Dinv     = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
-      const double * __restrict__ valid    = level->my_boxes[box].vectors[VECTOR_VALID ] + ghosts*(1+jStride+kStride); // cell is inside the domain
-          
-
-      if( (s&0x1)==0 ){ // forward sweep... hard to thread
-        for(k=0;k<dim;k++){
-        for(j=0;j<dim;j++){
-        for(i=0;i<dim;i++){
-          int ijk = i + j*jStride + k*kStride;
-          double Ax = apply_op_ijk(phi);
-          phi[ijk] = phi[ijk] + Dinv[ijk]*(rhs[ijk]-Ax);
-        }}}
-      }else{ // backward sweep... hard to thread
-        for(k=dim-1;k>=0;k--){
-        for(j=dim-1;j>=0;j--){
-        for(i=dim-1;i>=0;i--){
-          int ijk = i + j*jStride + k*kStride;
-          double Ax = apply_op_ijk(phi);
-          phi[ijk] = phi[ijk] + Dinv[ijk]*(rhs[ijk]-Ax);
-        }}}
+    #if defined(SYMGS_WAVEFRONT)
+    if( level->brick || (level->num_my_boxes < level->num_threads) ){ // otherwise threading across boxes suffices (and avoids a barrier per wavefront)
+      const int m = stencil_get_radius()+1;
+      const int nb = level->brick ? 1 : level->num_my_boxes; // boxes of a brick read (in place) the interiors of their neighbors and are swept one at a time
+      int b0;
+      for(b0=0;b0<level->num_my_boxes;b0+=nb){
+        const int first = ( level->brick && (s&0x1) ) ? level->num_my_boxes-1-b0 : b0; // a brick's backward sweep visits its boxes in reverse
+        const int   dim = level->box_dim;
+        const int waves = dim + m*(dim-1);
+        int t;
+        #ifdef _OPENMP
+        #pragma omp parallel private(t)
+        #endif
+        for(t=0;t<waves;t++){
+          const int w = ((s&0x1)==0) ? t : waves-1-t; // forward sweep visits the wavefronts in order, backward in reverse
+          int klo = (w-(dim-1)+m-1)/m;if(klo<0    )klo=0;
+          int khi = (w        )/m;if(khi>dim-1)khi=dim-1;
+          const int lines = khi-klo+1;
+          int n;
+          #ifdef _OPENMP
+          #pragma omp for schedule(static)
+          #endif
+          for(n=0;n<nb*lines;n++){
+            const int k = klo + n%lines;
+            symgs_line(level,phi_id,rhs_id,a,b,first+n/lines,w-m*k,k,(s&0x1)==0);
+          }
+        }
       }
+    }else
+    #endif
+    {
+      int n,box;
+      #ifdef _OPENMP
+      #pragma omp parallel for private(n,box) if(!level->brick) // boxes of a brick read (in place) the interiors of their neighbors
+      #endif
+      for(n=0;n<level->num_my_boxes;n++){
+        box = ( level->brick && (s&0x1) ) ? level->num_my_boxes-1-n : n; // a brick's backward sweep visits its boxes in reverse
+        int i,j,k;
+        const int ghosts = level->box_ghosts;
+        const int jStride = level->my_boxes[box].jStride;
+        const int kStride = level->my_boxes[box].kStride;
+        const int     dim = level->my_boxes[box].dim;
+        const double h2inv = 1.0/(level->h*level->h);
+              double * __restrict__ phi      = level->my_boxes[box].vectors[       phi_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
+        const double * __restrict__ rhs      = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+        #ifdef USE_PACKED_COEFFICIENTS
+        const double * __restrict__ coefs    = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+        #else
+        #ifdef USE_HELMHOLTZ
+        const double * __restrict__ alpha    = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+        #endif
+        const double * __restrict__ beta_i   = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
+        const double * __restrict__ beta_j   = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
+        const double * __restrict__ beta_k   = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+        #endif
+        const double * __restrict__ Dinv     = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
+        #ifdef STENCIL_FUSE_BC
+        const valid_region_type valid        = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+        #endif
+
+
+        if( (s&0x1)==0 ){ // forward sweep... hard to thread
+          for(k=0;k<dim;k++){
+          for(j=0;j<dim;j++){
+          for(i=0;i<dim;i++){
+            int ijk = i + j*jStride + k*kStride;
+            double Ax = apply_op_ijk(phi);
+            phi[ijk] = phi[ijk] + Dinv_ijk()*(rhs[ijk]-Ax);
+          }}}
+        }else{ // backward sweep... hard to thread
+          for(k=dim-1;k>=0;k--){
+          for(j=dim-1;j>=0;j--){
+          for(i=dim-1;i>=0;i--){
+            int ijk = i + j*jStride + k*kStride;
+            double Ax = apply_op_ijk(phi);
+            phi[ijk] = phi[ijk] + Dinv_ijk()*(rhs[ijk]-Ax);
+          }}}
+        }
 
-    } // boxes
+      } // boxes
+    }
     level->timers.smooth += (double)(getTime()-_timeStart);
   } // s-loop
 }
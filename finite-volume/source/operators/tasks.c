@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Task-graph (-DUSE_TASKS) execution of GSRB smooths (and an optional trailing residual)
+// Normally, every sweep is an exchange_boundary(), apply_BCs(), and a parallel for across blocks, each ending in a barrier.
+// Here, each local ghost zone copy, each MPI unpack, and each box's BC+sweep is an OpenMP task whose dependencies are
+// tokens for the data (data[box]) and ghost zones (ghosts[box]) of each box.  Thus, a box may begin its next sweep (or its
+// residual) as soon as its own sweep is done and the boxes that fill its ghost zones have finished theirs.
+// MPI calls are made by the master thread (MPI_THREAD_FUNNELED) which generates the tasks.  Boxes without off-process
+// neighbors are scheduled before waiting on MPI (or the hand-off to the communication thread) so that their sweeps overlap
+// communication.  Each receive buffer is unpacked (as tasks) as soon as it arrives.
+// Levels with fewer boxes than threads continue to thread within boxes (across blocks).  GPU levels are never task-based.
+//------------------------------------------------------------------------------------------------------------------------------
+#ifdef USE_TASKS
+#define TASK_GSRB     0
+#define TASK_RESIDUAL 1
+
+
+// one step of the graph... exchange vector id and then apply GSRB sweep s or the residual to each box
+void tasks_step(level_type *level, level_type *views, char *data, char *ghosts, char *remote, int id, int op, int x_id, int rhs_id, int res_id, double a, double b, int s){
+  int shape = stencil_get_shape();
+  if(shape>=STENCIL_MAX_SHAPES)shape=STENCIL_SHAPE_BOX;
+  communicator_type *comm = &level->exchange_ghosts[shape];
+  int n,box;
+
+  #ifdef USE_MPI
+  int my_tag = (level->tag<<4) | shape;
+  int nMessages = comm->num_recvs + comm->num_sends;
+  MPI_Request *recv_requests = comm->requests;
+  MPI_Request *send_requests = comm->requests + comm->num_recvs;
+  #ifdef USE_MPI_DATATYPES
+  int nZeroCopy = 0;
+  #endif
+  if(nMessages){
+    // send buffers are packed from the results of the previous step which must also have finished unpacking the receive buffers...
+    #pragma omp taskwait
+    for(n=0;n<comm->num_recvs;n++){
+      if(comm->recv_sizes[n]==0){recv_requests[n]=MPI_REQUEST_NULL;continue;}
+      MPI_Irecv(comm->recv_buffers[n],comm->recv_sizes[n],MPI_DOUBLE,comm->recv_ranks[n],my_tag,MPI_COMM_WORLD,&recv_requests[n]);
+    }
+    #ifdef USE_MPI_DATATYPES
+    if(comm->zc_requests){
+      for(n=0;n<comm->num_recvs;n++)if(comm->recv_types[n]!=MPI_DATATYPE_NULL)MPI_Irecv(level->vectors[id],1,comm->recv_types[n],comm->recv_ranks[n],my_tag|0x8,MPI_COMM_WORLD,&comm->zc_requests[nZeroCopy++]);
+      for(n=0;n<comm->num_sends;n++)if(comm->send_types[n]!=MPI_DATATYPE_NULL)MPI_Isend(level->vectors[id],1,comm->send_types[n],comm->send_ranks[n],my_tag|0x8,MPI_COMM_WORLD,&comm->zc_requests[nZeroCopy++]);
+    }
+    #endif
+    for(n=0;n<comm->num_blocks[0];n++){
+      #pragma omp task firstprivate(n)
+      CopyBlock(level,id,&comm->blocks[0][n]);
+    }
+    #pragma omp taskwait
+    for(n=0;n<comm->num_sends;n++){
+      if(comm->send_sizes[n]==0){send_requests[n]=MPI_REQUEST_NULL;continue;}
+      MPI_Isend(comm->send_buffers[n],comm->send_sizes[n],MPI_DOUBLE,comm->send_ranks[n],my_tag,MPI_COMM_WORLD,&send_requests[n]);
+    }
+  }
+  #ifdef USE_COMM_THREAD
+  comm_job_type job = {level,id,0,NULL,1.0,comm,nMessages,comm->requests,comm->status,0.0,0.0};
+  if(nMessages)comm_thread_post(&job); // the communication thread waits and unpacks while tasks run
+  #endif
+  #endif
+
+  // local ghost zone copies...
+  for(n=0;n<comm->num_blocks[1];n++){
+    blockCopy_type *block = &comm->blocks[1][n];
+    #pragma omp task firstprivate(block) depend(in:data[block->read.box]) depend(inout:ghosts[block->write.box])
+    CopyBlock(level,id,block);
+  }
+
+  // boxes whose ghost zones are filled on-process can proceed while MPI is in flight...
+  for(box=0;box<level->num_my_boxes;box++)remote[box]=0;
+  for(n=0;n<comm->num_blocks[2];n++)remote[comm->blocks[2][n].write.box]=1;
+  #ifdef USE_MPI_DATATYPES // boxes sent directly from (received directly into) must also wait for MPI
+  for(n=0;n<comm->num_zc_blocks[0];n++)remote[comm->zc_blocks[0][n].read.box ]=1;
+  for(n=0;n<comm->num_zc_blocks[2];n++)remote[comm->zc_blocks[2][n].write.box]=1;
+  #endif
+  for(box=0;box<level->num_my_boxes;box++)if(!remote[box]){
+    #pragma omp task firstprivate(box) depend(in:ghosts[box]) depend(inout:data[box])
+    {
+      apply_BCs(&views[box],id,shape);
+      if(op==TASK_RESIDUAL)residual_blocks(&views[box],res_id,x_id,rhs_id,a,b);
+                      else     gsrb_blocks(&views[box],       x_id,rhs_id,a,b,s);
+    }
+  }
+
+  #ifdef USE_MPI
+  #ifdef USE_COMM_THREAD
+  if(nMessages){
+    comm_thread_wait(&job);
+    level->timers.ghostZone_wait   += job.time_wait;
+    level->timers.ghostZone_unpack += job.time_unpack;
+  }
+  #else
+  // unpack each receive buffer as soon as it arrives...
+  int remaining = comm->num_recvs;
+  while(remaining>0){
+    int m,count,arrived[comm->num_recvs];
+    MPI_Waitsome(comm->num_recvs,recv_requests,&count,arrived,comm->status);
+    if(count==MPI_UNDEFINED)break;
+    remaining-=count;
+    for(m=0;m<count;m++)
+    for(n=comm->unpack_start[arrived[m]];n<comm->unpack_start[arrived[m]+1];n++){
+      blockCopy_type *block = &comm->blocks[2][n];
+      #pragma omp task firstprivate(block) depend(inout:ghosts[block->write.box])
+      CopyBlock(level,id,block);
+    }
+  }
+  if(comm->num_sends)MPI_Waitall(comm->num_sends,send_requests,comm->status);
+  #endif
+  #ifdef USE_MPI_DATATYPES
+  if(nZeroCopy)MPI_Waitall(nZeroCopy,comm->zc_requests,MPI_STATUSES_IGNORE);
+  #endif
+  #endif
+
+  // boxes that required off-process ghost zones...
+  for(box=0;box<level->num_my_boxes;box++)if(remote[box]){
+    #pragma omp task firstprivate(box) depend(in:ghosts[box]) depend(inout:data[box])
+    {
+      apply_BCs(&views[box],id,shape);
+      if(op==TASK_RESIDUAL)residual_blocks(&views[box],res_id,x_id,rhs_id,a,b);
+                      else     gsrb_blocks(&views[box],       x_id,rhs_id,a,b,s);
+    }
+  }
+}
+
+
+// build a shallow copy of the level for each box whose block and BC lists are restricted to that box
+// returns 0 if a list is not grouped by box
+int tasks_build_views(level_type *level, level_type *views){
+  int box,n,shape;
+  for(box=0;box<level->num_my_boxes;box++){
+    views[box] = *level;
+    views[box].num_my_blocks = 0;
+    for(shape=0;shape<STENCIL_MAX_SHAPES;shape++)views[box].boundary_condition.num_blocks[shape]=0;
+  }
+  for(n=0;n<level->num_my_blocks;n++){
+    level_type *view = &views[level->my_blocks[n].read.box];
+    if(view->num_my_blocks==0)view->my_blocks = level->my_blocks+n;
+    else if(view->my_blocks+view->num_my_blocks != level->my_blocks+n)return(0);
+    view->num_my_blocks++;
+  }
+  for(shape=0;shape<STENCIL_MAX_SHAPES;shape++){
+    for(n=0;n<level->boundary_condition.num_blocks[shape];n++){
+      level_type *view = &views[level->boundary_condition.blocks[shape][n].read.box];
+      if(view->boundary_condition.num_blocks[shape]==0)view->boundary_condition.blocks[shape] = level->boundary_condition.blocks[shape]+n;
+      else if(view->boundary_condition.blocks[shape]+view->boundary_condition.num_blocks[shape] != level->boundary_condition.blocks[shape]+n)return(0);
+      view->boundary_condition.num_blocks[shape]++;
+    }
+  }
+  return(1);
+}
+#endif
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+// returns 0 if this level should not be executed as a task graph (the caller then uses the bulk synchronous implementation)
+int tasks_gsrb(level_type *level, int x_id, int rhs_id, int res_id, double a, double b){
+  #ifdef USE_TASKS
+  if(level->use_cuda)return(0);
+  if(level->brick)return(0); // boxes of a brick share ghost zones and thus have no per-box dependencies
+  if( (level->num_threads<2) || (level->num_my_boxes<level->num_threads) )return(0);
+  const int num_smooths = (level->num_smooths>0) ? level->num_smooths : GSRB_NUM_SMOOTHS;
+  int s;
+
+  level_type *views = (level_type*)malloc(level->num_my_boxes*sizeof(level_type));
+  char *tokens = (char*)malloc(3*level->num_my_boxes*sizeof(char));
+  if( (views==NULL) || (tokens==NULL) ){fprintf(stderr,"malloc failed - tasks_gsrb\n");exit(0);}
+  if(!tasks_build_views(level,views)){free(views);free(tokens);return(0);}
+  char *data   = tokens;
+  char *ghosts = tokens +   level->num_my_boxes;
+  char *remote = tokens + 2*level->num_my_boxes;
+
+  double _timeStart = getTime();
+  #pragma omp parallel
+  {
+    #pragma omp master
+    {
+      for(s=0;s<2*num_smooths;s++){
+        #ifdef GSRB_OOP // out-of-place GSRB ping pongs between x and VECTOR_TEMP
+        int id = ((s&1)==0) ? x_id : VECTOR_TEMP;
+        #else
+        int id = x_id;
+        #endif
+        tasks_step(level,views,data,ghosts,remote,id,TASK_GSRB,x_id,rhs_id,-1,a,b,s);
+      }
+      if(res_id>=0)tasks_step(level,views,data,ghosts,remote,x_id,TASK_RESIDUAL,x_id,rhs_id,res_id,a,b,0);
+    }
+  } // the implicit barrier ensures all tasks have completed
+  // per-box timers are discarded.  The whole graph (including any residual) is attributed to smooth
+  level->timers.smooth += (double)(getTime()-_timeStart);
+
+  free(views);
+  free(tokens);
+  return(1);
+  #else
+  return(0);
+  #endif
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+// smooth() followed by residual()... fused into one task graph when possible
+void smooth_and_residual(level_type *level, int x_id, int rhs_id, int res_id, double a, double b){
+  if( (level->smoother==SMOOTHER_GSRB) && tasks_gsrb(level,x_id,rhs_id,res_id,a,b) )return;
+    smooth(level,x_id,rhs_id,a,b);
+  residual(level,res_id,x_id,rhs_id,a,b);
+}
+//------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Unpack the MPI receive buffers of a communicator in the order in which the messages arrive (rather than after MPI_Waitall)
+// The master thread waits (MPI_Waitsome) on the outstanding receives and creates a task for each block of each buffer that
+// has arrived.  The remaining threads execute these tasks while the master waits on the rest of the messages.
+// The unpack list must be grouped by buffer (see group_blocks_by_buffer()).
+// increment!=0 unpacks with IncrementBlock() (i.e. interpolation), otherwise CopyBlock()
+// interpolate!=NULL instead interpolates each block from the coarse data in the buffer (-DUSE_RECEIVER_INTERPOLATION)
+// threaded==0 unpacks on the calling thread (e.g. the communication thread)
+// NOTE, this only waits on the receives.  The caller must still complete the sends.
+//------------------------------------------------------------------------------------------------------------------------------
+typedef void (*interpolation_block_type)(level_type *level_f, int id_f, double prescale_f, level_type *level_c, int id_c, blockCopy_type *block);
+
+#ifdef USE_MPI
+void unpack_in_arrival_order(level_type *level, int id, int increment, interpolation_block_type interpolate, double prescale, communicator_type *comm, MPI_Request *recv_requests, MPI_Status *status, int threaded, double *time_wait, double *time_unpack){
+  int num_recvs = comm->num_recvs;
+  if(num_recvs<=0)return;
+  int arrived[num_recvs];
+  int remaining = num_recvs;
+  double _timeWait = 0.0;
+  double _timeStart = getTime();
+
+  #pragma omp parallel if(threaded && (comm->num_blocks[2]>1))
+  {
+    #pragma omp master
+    while(remaining>0){
+      int m,b,count;
+      double _timeWaitStart = getTime();
+      MPI_Waitsome(num_recvs,recv_requests,&count,arrived,status);
+      _timeWait += (getTime()-_timeWaitStart);
+      if(count==MPI_UNDEFINED)break;
+      remaining-=count;
+      for(m=0;m<count;m++){
+        int r = arrived[m];
+        for(b=comm->unpack_start[r];b<comm->unpack_start[r+1];b++){
+          #pragma omp task firstprivate(b)
+          if(interpolate)interpolate(level,id,prescale,NULL,-1,&comm->blocks[2][b]); // reads only the buffer
+          else if(increment)IncrementBlock(level,id,prescale,&comm->blocks[2][b]);
+                       else     CopyBlock(level,id,         &comm->blocks[2][b]);
+        }
+      }
+    }
+  } // the implicit barrier ensures all unpacks have completed
+
+  *time_wait   += _timeWait;
+  *time_unpack += (getTime()-_timeStart) - _timeWait;
+}
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Samuel Williams
+// SWWilliams@lbl.gov
+// Lawrence Berkeley National Lab
+//------------------------------------------------------------------------------------------------------------------------------
+// z-line relaxation... each (i,j) column of a box is relaxed by solving its k-line (tri- or pentadiagonal) system exactly
+// in correction form:  L_line e = (rhs-Ax)_line ; x += e
+// L_line's diagonal is D (i.e. 1/Dinv, which includes the effects of the boundary conditions) and its off-diagonals are
+// the operator's in-line coefficients (Akm2_ijk()...Akp2_ijk()).  Couplings beyond the box (or introduced by the BC's) are
+// simply lagged through the residual.  Columns are colored by their global (i,j) modulo radius+1 (i.e. zebra for radius 1)
+// so that no column's stencil reaches another column of the same color.  Each color is threaded across (box,j) rows whose
+// columns are solved together (the Thomas algorithm is vectorized across the columns of a row).
+// The forward sweep visits the colors in order and the backward sweep in reverse.
+// The boxes of a brick read their k-neighbors' interiors in place and so are swept in two phases (even/odd boxes in k).
+// NOTE, this smoother is experimental.  Only the k-lines are relaxed (there is no alternation of directions), so it is only
+// effective for anisotropies in k and is not among the candidates considered by --tune-smoothers.
+//------------------------------------------------------------------------------------------------------------------------------
+#ifndef STENCIL_LINE_COEFFICIENTS
+  #warning This operator does not provide its k-line coefficients.  The zline smoother degenerates to a multicolor point Gauss-Seidel
+  #define Akm2_ijk() 0.0
+  #define Akm1_ijk() 0.0
+  #define Akp1_ijk() 0.0
+  #define Akp2_ijk() 0.0
+#endif
+//------------------------------------------------------------------------------------------------------------------------------
+void zline_color(level_type * level, int x_id, int rhs_id, double a, double b, int color, int kparity){
+  const int    m = stencil_get_radius()+1; // colors in i and j
+  const int   ci = color%m;
+  const int   cj = color/m;
+  const int  dim = level->box_dim;
+  const int  nc  = (dim+m-1)/m; // max columns of a color in a row of a box
+  int n;
+
+  #ifdef _OPENMP
+  #pragma omp parallel private(n)
+  #endif
+  {
+    // forward elimination of the pentadiagonal systems yields (unit diagonal) U's two superdiagonals and the transformed rhs
+    #ifdef _OPENMP
+    double * __restrict__ u1 = level->line_scratch + omp_get_thread_num()*3*dim*dim;
+    #else
+    double * __restrict__ u1 = level->line_scratch;
+    #endif
+    double * __restrict__ u2 = u1 +   dim*nc;
+    double * __restrict__ y  = u1 + 2*dim*nc;
+
+    #ifdef _OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for(n=0;n<level->num_my_boxes*dim;n++){
+      const int box = n/dim;
+      const int   j = n%dim;
+      if( ((level->my_boxes[box].low.j+j)%m) != cj )continue; // this row's columns are of another color
+      if( (kparity>=0) && (((level->my_boxes[box].low.k/dim)&1) != kparity) )continue; // (bricks) box is swept in the other phase
+      const int  i0 = ( ( (ci-level->my_boxes[box].low.i)%m )+m )%m;
+      const int ncol = (dim-i0+m-1)/m;
+      int i,k,c;
+      const double h2inv = 1.0/(level->h*level->h);
+      const int ghosts =  level->box_ghosts;
+      const int jStride = level->my_boxes[box].jStride;
+      const int kStride = level->my_boxes[box].kStride;
+            double * __restrict__ x        = level->my_boxes[box].vectors[         x_id] + ghosts*(1+jStride+kStride); // i.e. [0] = first non ghost zone point
+      const double * __restrict__ rhs      = level->my_boxes[box].vectors[       rhs_id] + ghosts*(1+jStride+kStride);
+      #ifdef USE_PACKED_COEFFICIENTS
+      const double * __restrict__ coefs    = level->my_boxes[box].coefficients + PACKED_COEFS*ghosts*(1+jStride+kStride);
+      #else
+      #ifdef USE_HELMHOLTZ
+      const double * __restrict__ alpha    = level->my_boxes[box].vectors[VECTOR_ALPHA ] + ghosts*(1+jStride+kStride);
+      #endif
+      const double * __restrict__ beta_i   = level->my_boxes[box].vectors[VECTOR_BETA_I] + ghosts*(1+jStride+kStride);
+      const double * __restrict__ beta_j   = level->my_boxes[box].vectors[VECTOR_BETA_J] + ghosts*(1+jStride+kStride);
+      const double * __restrict__ beta_k   = level->my_boxes[box].vectors[VECTOR_BETA_K] + ghosts*(1+jStride+kStride);
+      #endif
+      const double * __restrict__ Dinv     = level->my_boxes[box].vectors[VECTOR_DINV  ] + ghosts*(1+jStride+kStride);
+      #ifdef STENCIL_FUSE_BC
+      const valid_region_type valid        = level->my_boxes[box].valid; // cells (box-relative) inside the domain
+      #endif
+
+      // forward elimination (the residual only reads x, which is not updated until the back substitution)...
+      for(k=0;k<dim;k++){
+      for(c=0;c<ncol;c++){
+        i = i0 + c*m;
+        const int ijk = i + j*jStride + k*kStride;
+        const int  kc = k*nc + c;
+        double  e = (k>=2    ) ? Akm2_ijk() : 0.0; // couplings to cells outside of this box are lagged
+        double  f = (k>=1    ) ? Akm1_ijk() : 0.0;
+        double  d =        1.0/Dinv_ijk();
+        double c1 = (k<dim-1 ) ? Akp1_ijk() : 0.0;
+        double c2 = (k<dim-2 ) ? Akp2_ijk() : 0.0;
+        double  r = rhs[ijk]-apply_op_ijk(x);
+        if(k>=2){f-=e*u1[kc-2*nc];d-=e*u2[kc-2*nc];r-=e*y[kc-2*nc];}
+        if(k>=1){d-=f*u1[kc-  nc];c1-=f*u2[kc-  nc];r-=f*y[kc-  nc];}
+        u1[kc] = c1/d;
+        u2[kc] = c2/d;
+        y[kc]  =  r/d;
+      }}
+
+      // back substitution (y becomes the correction)...
+      for(k=dim-1;k>=0;k--){
+      for(c=0;c<ncol;c++){
+        i = i0 + c*m;
+        const int ijk = i + j*jStride + k*kStride;
+        const int  kc = k*nc + c;
+        if(k<dim-1)y[kc]-=u1[kc]*y[kc+  nc];
+        if(k<dim-2)y[kc]-=u2[kc]*y[kc+2*nc];
+        x[ijk] += y[kc];
+      }}
+    }
+  }
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------
+void smooth_zline(level_type * level, int x_id, int rhs_id, double a, double b){
+  int s,c,p;
+  const int num_smooths = (level->num_smooths>0) ? level->num_smooths : ZLINE_NUM_SMOOTHS;
+  const int m = stencil_get_radius()+1;
+
+  for(s=0;s<2*num_smooths;s++){ // there are two sweeps (forward/backward) per smooth
+    exchange_boundary(level,x_id,stencil_get_shape());
+            apply_BCs(level,x_id,stencil_get_shape());
+
+    double _timeStart = getTime();
+    for(c=0;c<m*m;c++){
+      int color = ((s&0x1)==0) ? c : m*m-1-c;
+      if(level->brick){for(p=0;p<2;p++)zline_color(level,x_id,rhs_id,a,b,color,p);}
+                  else                 zline_color(level,x_id,rhs_id,a,b,color,-1);
+    }
+    level->timers.smooth += (double)(getTime()-_timeStart);
+  } // s-loop
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------
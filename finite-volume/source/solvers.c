@@ -13,23 +13,55 @@
 #include "defines.h"
 #include "level.h"
 #include "operators.h"
+#include "solvers.h"
 //------------------------------------------------------------------------------------------------------------------------------
-#ifdef USE_BICGSTAB
-#include "solvers/bicgstab.c"
-#elif  USE_CG
-#include "solvers/cg.c"
-#elif  USE_CABICGSTAB
+// all bottom solvers are compiled in and selected at runtime via level->bottom_solver
+// NOTE, the CA solvers must come first as bicgstab.c/cg.c #define KRYLOV_DIAGONAL_PRECONDITION
 #include "solvers/cabicgstab.c"
-#elif  USE_CACG
 #include "solvers/cacg.c"
-#endif
+#include "solvers/bicgstab.c"
+#include "solvers/cg.c"
+//------------------------------------------------------------------------------------------------------------------------------
+const char * bottom_solver_names[NUM_BOTTOM_SOLVERS] = {"smooth","bicgstab","cg","cabicgstab","cacg"}; // indexed by BOTTOM_*
+
+
+// bottom solver selected at compile time (-DUSE_BICGSTAB, ...)
+int IterativeSolver_GetDefault(){
+  #if   defined(USE_BICGSTAB)
+  return(BOTTOM_BICGSTAB);
+  #elif defined(USE_CG)
+  return(BOTTOM_CG);
+  #elif defined(USE_CABICGSTAB)
+  return(BOTTOM_CABICGSTAB);
+  #elif defined(USE_CACG)
+  return(BOTTOM_CACG);
+  #else
+  return(BOTTOM_SMOOTH);
+  #endif
+}
+
+
+// returns -1 if the name is not recognized
+int IterativeSolver_GetID(const char *name){
+  int s;
+  for(s=0;s<NUM_BOTTOM_SOLVERS;s++)if(strcmp(name,bottom_solver_names[s])==0)return(s);
+  return(-1);
+}
+
+
+const char * IterativeSolver_GetName(int bottom_solver){
+  if( (bottom_solver<0) || (bottom_solver>=NUM_BOTTOM_SOLVERS) )return("unknown");
+  return(bottom_solver_names[bottom_solver]);
+}
+
+
 //------------------------------------------------------------------------------------------------------------------------------
 void IterativeSolver(level_type * level, int u_id, int f_id, double a, double b, double desired_reduction_in_norm){ 
   if(!level->active)return;
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
   if(level->must_subtract_mean==-1){
     level->must_subtract_mean=0;
-    int alpha_is_zero = (dot(level,VECTOR_ALPHA,VECTOR_ALPHA) == 0.0);
+    int alpha_is_zero = level->constant_coefficients ? (level->constant_alpha==0.0) : (dot(level,VECTOR_ALPHA,VECTOR_ALPHA) == 0.0);
     if( (level->boundary_condition.type==BC_PERIODIC) && ((a==0) || (alpha_is_zero)) )level->must_subtract_mean = 1; // Poisson with Periodic BCs
   }
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -47,15 +79,12 @@ void IterativeSolver(level_type * level, int u_id, int f_id, double a, double b,
   }
   #endif
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-  #ifdef USE_BICGSTAB
-    BiCGStab(level,u_id,f_id,a,b,desired_reduction_in_norm);
-  #elif  USE_CG
-    CG(level,u_id,f_id,a,b,desired_reduction_in_norm);
-  #elif  USE_CABICGSTAB
-    CABiCGStab(level,u_id,f_id,a,b,desired_reduction_in_norm);
-  #elif  USE_CACG
-    CACG(level,u_id,f_id,a,b,desired_reduction_in_norm);
-  #else 
+  switch(level->bottom_solver){
+  case BOTTOM_BICGSTAB:   BiCGStab(level,u_id,f_id,a,b,desired_reduction_in_norm);break;
+  case BOTTOM_CG:               CG(level,u_id,f_id,a,b,desired_reduction_in_norm);break;
+  case BOTTOM_CABICGSTAB: CABiCGStab(level,u_id,f_id,a,b,desired_reduction_in_norm);break;
+  case BOTTOM_CACG:           CACG(level,u_id,f_id,a,b,desired_reduction_in_norm);break;
+  default:{
     // just point relaxation via multiple smooth()'s
     if(level->must_subtract_mean == 1){
       double mean_of_u = mean(level,u_id);
@@ -79,23 +108,21 @@ void IterativeSolver(level_type * level, int u_id, int f_id, double a, double b,
       if(norm_of_r == 0.0){converged=1;break;}
       if(norm_of_r < desired_reduction_in_norm*norm_of_r0){converged=1;break;}
     }
-  #endif
+  }break;
+  }
   //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 }
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-int IterativeSolver_NumVectors(){
+int IterativeSolver_NumVectors(int bottom_solver){
   // additionally number of vectors required by an iterative solver...
-  #ifdef USE_BICGSTAB
-  return(8);                  // BiCGStab requires additional vectors r0,r,p,s,Ap,As
-  #elif  USE_CG
-  return(5);                  // CG requires extra vectors r0,r,p,Ap,z
-  #elif  USE_CABICGSTAB
-  return(4+4*CA_KRYLOV_S);    // CABiCGStab requires additional vectors rt,p,r,P[2s+1],R[2s].
-  #elif  USE_CACG
-  return(4+2*CA_KRYLOV_S);    // CACG requires additional vectors r0,p,r,P[s+1],R[s].
-  #endif
+  switch(bottom_solver){
+  case BOTTOM_BICGSTAB:   return(8);                  // BiCGStab requires additional vectors r0,r,p,s,Ap,As
+  case BOTTOM_CG:         return(5);                  // CG requires extra vectors r0,r,p,Ap,z
+  case BOTTOM_CABICGSTAB: return(4+4*CA_KRYLOV_S);    // CABiCGStab requires additional vectors rt,p,r,P[2s+1],R[2s].
+  case BOTTOM_CACG:       return(4+2*CA_KRYLOV_S);    // CACG requires additional vectors r0,p,r,P[s+1],R[s].
+  }
   return(0);                  // simply doing multiple smooths requires no extra vectors
 }
 //------------------------------------------------------------------------------------------------------------------------------
@@ -6,7 +6,17 @@
 #ifndef SOLVERS_H
 #define SOLVERS_H
 //------------------------------------------------------------------------------------------------------------------------------
-void IterativeSolver(level_type *level, int u_id, int f_id, double a, double b, double desired_reduction_in_norm);
-int  IterativeSolver_NumVectors();
+#define BOTTOM_SMOOTH     0 // just point relaxation via multiple smooth()'s
+#define BOTTOM_BICGSTAB   1
+#define BOTTOM_CG         2
+#define BOTTOM_CABICGSTAB 3
+#define BOTTOM_CACG       4
+#define NUM_BOTTOM_SOLVERS 5
+//------------------------------------------------------------------------------------------------------------------------------
+void IterativeSolver(level_type *level, int u_id, int f_id, double a, double b, double desired_reduction_in_norm); // dispatches on level->bottom_solver
+int  IterativeSolver_NumVectors(int bottom_solver);
+int  IterativeSolver_GetDefault();
+int  IterativeSolver_GetID(const char *name);
+const char * IterativeSolver_GetName(int bottom_solver);
 //------------------------------------------------------------------------------------------------------------------------------
 #endif
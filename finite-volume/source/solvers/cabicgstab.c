@@ -18,6 +18,8 @@
 #define    CA_KRYLOV_S     4
 #endif
 //------------------------------------------------------------------------------------------------------------------------------
+#ifndef CA_KRYLOV_HELPERS // shared with the other CA Krylov solver when both are compiled in
+#define CA_KRYLOV_HELPERS
 #include "matmul.c"
 //------------------------------------------------------------------------------------------------------------------------------
 // z[r] = alpha*A[r][c]*x[c]+beta*y[r]   // [row][col]
@@ -43,6 +45,7 @@ static inline void zero(double * z, int n){ // z[n] = 0.0
     z[nn] = 0.0;
   }
 }
+#endif
 
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -150,8 +153,10 @@ void CABiCGStab(level_type * level, int e_id, int R_id, double a, double b, doub
                                          g[i]    = Gg[k++];                                     // last element in row goes to g[].
     }
 
-    for(i=0;i<4*ca_krylov_s+1;i++)aj[i]=0.0;aj[              0]=1.0;                        // initialized based on (3.26)
-    for(i=0;i<4*ca_krylov_s+1;i++)cj[i]=0.0;cj[2*ca_krylov_s+1]=1.0;                        // initialized based on (3.26)
+    for(i=0;i<4*ca_krylov_s+1;i++)aj[i]=0.0;                                                // initialized based on (3.26)
+    aj[0]=1.0;
+    for(i=0;i<4*ca_krylov_s+1;i++)cj[i]=0.0;                                                // initialized based on (3.26)
+    cj[2*ca_krylov_s+1]=1.0;
     for(i=0;i<4*ca_krylov_s+1;i++)ej[i]=0.0;                                                  // initialized based on (3.26)
 
     for(n=0;n<ca_krylov_s;n++){                                                               // for(n=0;n<ca_krylov_s;n++){
@@ -385,8 +390,10 @@ void CABiCGStab(level_type * level, int e_id, int R_id, double a, double b, doub
                                          g[i]    = Gg[k++];                                     // last element in row goes to g[].
     }
 
-    for(i=0;i<4*ca_krylov_s+1;i++)aj[i]=0.0;aj[              0]=1.0;                        // initialized based on (3.26)
-    for(i=0;i<4*ca_krylov_s+1;i++)cj[i]=0.0;cj[2*ca_krylov_s+1]=1.0;                        // initialized based on (3.26)
+    for(i=0;i<4*ca_krylov_s+1;i++)aj[i]=0.0;                                                // initialized based on (3.26)
+    aj[0]=1.0;
+    for(i=0;i<4*ca_krylov_s+1;i++)cj[i]=0.0;                                                // initialized based on (3.26)
+    cj[2*ca_krylov_s+1]=1.0;
     for(i=0;i<4*ca_krylov_s+1;i++)ej[i]=0.0;                                                  // initialized based on (3.26)
 
     for(n=0;n<ca_krylov_s;n++){                                                               // for(n=0;n<ca_krylov_s;n++){
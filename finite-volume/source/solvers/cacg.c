@@ -13,6 +13,8 @@
 #define    CA_KRYLOV_S     4
 #endif
 //------------------------------------------------------------------------------------------------------------------------------
+#ifndef CA_KRYLOV_HELPERS // shared with the other CA Krylov solver when both are compiled in
+#define CA_KRYLOV_HELPERS
 #include "matmul.c"
 //------------------------------------------------------------------------------------------------------------------------------
 // z[r] = alpha*A[r][c]*x[c]+beta*y[r]   // [row][col]
@@ -38,6 +40,7 @@ static inline void zero(double * z, int n){ // z[n] = 0.0
     z[nn] = 0.0;
   }
 }
+#endif
 
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -119,8 +122,10 @@ void CACG(level_type * level, int e_id, int R_id, double a, double b, double des
     }
 
 
-    for(i=0;i<2*CA_KRYLOV_S+1;i++)aj[i]=0.0;aj[               0]=1.0;                         // initialized based on (???)
-    for(i=0;i<2*CA_KRYLOV_S+1;i++)cj[i]=0.0;cj[CA_KRYLOV_S+1]=1.0;                          // initialized based on (???)
+    for(i=0;i<2*CA_KRYLOV_S+1;i++)aj[i]=0.0;                                                  // initialized based on (???)
+    aj[0]=1.0;
+    for(i=0;i<2*CA_KRYLOV_S+1;i++)cj[i]=0.0;                                                // initialized based on (???)
+    cj[CA_KRYLOV_S+1]=1.0;
     for(i=0;i<2*CA_KRYLOV_S+1;i++)ej[i]=0.0;                                                  // initialized based on (???)
 
     for(n=0;n<CA_KRYLOV_S;n++){                                                               // for(n=0;n<CA_KRYLOV_S;n++){